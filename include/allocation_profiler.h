@@ -0,0 +1,110 @@
+#ifndef ALLOCATION_PROFILER_H
+#define ALLOCATION_PROFILER_H
+
+//===-- qlogo/allocation_profiler.h - AllocationProfiler class definition -------*- C++ -*-===//
+//
+// Copyright 2017-2024 Jason Sikes
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the conditions specified in the
+// license found in the LICENSE file in the project root.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the declaration of the AllocationProfiler class, which
+/// attributes every Datum that is allocated to the instruction and procedure
+/// that allocated it.
+///
+/// The profiler is off unless qlogo is started with --profileAllocations. When it
+/// is on, the compiler brackets the code of every ASTNode with calls that push and
+/// pop the node on a stack of sites, and each Datum allocated with new is counted
+/// against the site on top of the stack.
+///
+//===----------------------------------------------------------------------===//
+
+#include "datum_ptr.h"
+#include <QHash>
+#include <QList>
+#include <cstddef>
+
+/// @brief Counts the Datum allocations made by each ASTNode.
+class AllocationProfiler
+{
+    struct Site
+    {
+        /// @brief The ASTNode, retained so that it can still be named in the report.
+        DatumPtr node;
+
+        /// @brief The name of the procedure that was running when the site was first seen.
+        DatumPtr procedure;
+
+        size_t count = 0;
+        size_t bytes = 0;
+    };
+
+    /// @brief The sites, keyed by ASTNode. Allocations made outside of any ASTNode,
+    /// e.g. by the reader, are keyed by nullptr.
+    QHash<const Datum *, Site> sites;
+
+    /// @brief The ASTNodes whose code is running, innermost last.
+    QList<const Datum *> siteStack;
+
+    void record(size_t size);
+    QList<Site> sortedSites() const;
+
+    AllocationProfiler() = default;
+    ~AllocationProfiler() = default;
+
+    AllocationProfiler(const AllocationProfiler &) = delete;
+    AllocationProfiler(AllocationProfiler &&) = delete;
+    AllocationProfiler &operator=(const AllocationProfiler &) = delete;
+    AllocationProfiler &operator=(AllocationProfiler &&) = delete;
+
+  public:
+    /// @brief True iff allocations are being counted. Set once, before anything is compiled.
+    static inline bool isActive = false;
+
+    /// @brief Get the singleton instance of the AllocationProfiler class.
+    /// @return The singleton instance of the AllocationProfiler class.
+    static AllocationProfiler &get()
+    {
+        // Never destroyed, since it retains ASTNodes that may outlive static destruction.
+        static auto *instance = new AllocationProfiler;
+        return *instance;
+    }
+
+    /// @brief Count a new Datum against the current site. Called by Datum::operator new.
+    /// @param size The size of the object.
+    static void allocated(size_t size)
+    {
+        if (isActive)
+            get().record(size);
+    }
+
+    /// @brief Make node the current site. Called by compiled code before the code of node.
+    void enter(const Datum *node)
+    {
+        siteStack.append(node);
+    }
+
+    /// @brief Restore the site that was current before node was entered.
+    /// @details Pops through node, so that sites left behind by code that exited early
+    /// (an error, OUTPUT or STOP) don't linger.
+    void leave(const Datum *node);
+
+    /// @brief Forget every current site, e.g. when control returns to the top level.
+    void resetSiteStack()
+    {
+        siteStack.clear();
+    }
+
+    /// @brief Get the counts by site.
+    /// @return A list of [procedure instruction count bytes] lists, most bytes first.
+    DatumPtr report() const;
+
+    /// @brief Print the counts by site on the standard error stream.
+    void printReport() const;
+};
+
+#endif // ALLOCATION_PROFILER_H
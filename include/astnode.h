@@ -58,7 +58,12 @@ class ASTNode : public Datum
     /// @brief Returns the child at the specified index.
     /// @param index The index of the child to return.
     /// @return The child at the specified index.
-    DatumPtr childAtIndex(unsigned index) const;
+    const DatumPtr &childAtIndex(unsigned index) const;
+
+    /// @brief Replaces the child at the specified index.
+    /// @param index The index of the child to replace.
+    /// @param aChild The new child.
+    void replaceChild(unsigned index, const DatumPtr &aChild);
 
     /// @brief Returns the number of children that this node owns.
     /// @return The number of children that this node owns.
@@ -75,7 +80,7 @@ class ASTNode : public Datum
     QString toString(ToStringFlags flags = ToStringFlags_None,
                      int printDepthLimit = -1,
                      int printWidthLimit = -1,
-                     VisitedSet *visited = nullptr) const override;
+                     VisitedSet *visited = nullptr) const;
 };
 
 #endif // DATUM_ASTNODE_H
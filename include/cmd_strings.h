@@ -98,6 +98,7 @@ const QString &cmdStrSE();
 const QString &cmdStrFPUT();
 const QString &cmdStrLPUT();
 const QString &cmdStrARRAY();
+const QString &cmdStrMDARRAY();
 const QString &cmdStrLISTTOARRAY();
 const QString &cmdStrARRAYTOLIST();
 const QString &cmdStrFIRST();
@@ -107,7 +108,9 @@ const QString &cmdStrBF();
 const QString &cmdStrBUTLAST();
 const QString &cmdStrBL();
 const QString &cmdStrITEM();
+const QString &cmdStrMDITEM();
 const QString &cmdStrSETITEM();
+const QString &cmdStrMDSETITEM();
 const QString &cmdStr_dot_SETITEM();
 const QString &cmdStr_dot_SETFIRST();
 const QString &cmdStr_dot_SETBF();
@@ -135,11 +138,19 @@ const QString &cmdStrASCII();
 const QString &cmdStrRAWASCII();
 const QString &cmdStrCHAR();
 const QString &cmdStrMEMBER();
+const QString &cmdStrREMDUP();
 const QString &cmdStrLOWERCASE();
 const QString &cmdStrUPPERCASE();
 const QString &cmdStrSTANDOUT();
 const QString &cmdStrPARSE();
 const QString &cmdStrRUNPARSE();
+const QString &cmdStrDICTIONARY();
+const QString &cmdStrDICTPUT();
+const QString &cmdStrDICTGET();
+const QString &cmdStrDICTREMOVE();
+const QString &cmdStrDICTKEYS();
+const QString &cmdStrDICTIONARYP();
+const QString &cmdStrDICTIONARY_Q();
 const QString &cmdStrFORWARD();
 const QString &cmdStrFD();
 const QString &cmdStrBACK();
@@ -225,5 +236,15 @@ const QString &cmdStrTO();
 const QString &cmdStr_dot_MACRO();
 const QString &cmdStrMAKE();
 const QString &cmdStrLOCAL();
+const QString &cmdStrPPROP();
+const QString &cmdStrGPROP();
+const QString &cmdStrREMPROP();
+const QString &cmdStrPLIST();
+const QString &cmdStrPLISTP();
+const QString &cmdStrPLIST_Q();
+const QString &cmdStrNODES();
+const QString &cmdStrHEAPSTATS();
+const QString &cmdStrHEAPSNAPSHOT();
+const QString &cmdStrALLOCATIONS();
 } // namespace StringConstants
 #endif // CMD_STRINGS_H
@@ -32,6 +32,7 @@
 #include <memory>
 
 struct Scaffold;
+class LogoIR;
 
 namespace llvm
 {
@@ -63,6 +64,23 @@ class Compiler
 
     std::unique_ptr<llvm::orc::LLJIT> lljit;
 
+    // The Logo-level IR of the function being compiled.
+    LogoIR *lir = nullptr;
+
+    // The values of the variable reads generated so far, for reuse by later reads.
+    QHash<const ASTNode *, llvm::Value *> readValues;
+
+    // The LPUT, SENTENCE or BUTLAST node whose output MAKE assigns back to the variable
+    // that holds its list input. That list may be changed in place.
+    const ASTNode *inPlaceListNode = nullptr;
+
+    // The name of the variable that MAKE assigns the output of inPlaceListNode to.
+    Word *inPlaceVarName = nullptr;
+
+    // The parent of the node whose generator is running, for generators that convert
+    // their own output to the type that the parent requested.
+    ASTNode *generatingParent = nullptr;
+
     // The hash table of compiled texts referenced by lists or ASTNodes.
     static QHash<Datum *, std::shared_ptr<CompiledText>> compiledTextTable;
 
@@ -107,6 +125,9 @@ class Compiler
     // Generate a call to a child node
     llvm::Value *generateChildOfNode(ASTNode *parent, const DatumPtr &, RequestReturnType);
 
+    // If Logo code may run while the value of a read is in use, hold a reference to it.
+    llvm::Value *generatePinnedRead(const DatumPtr &node, llvm::Value *value);
+
     // Generate a void return value using the ASTNode to represent the source (for blame).
     llvm::Value *generateVoidRetval(const DatumPtr &node);
 
@@ -156,6 +177,14 @@ class Compiler
     // Emit return "doesn't like" error if conversion not possible.
     llvm::Value *generateDoubleFromDatum(ASTNode *parent, llvm::Value *src);
 
+    // Output a member of a container as a number. If isPacked is true, the member is a
+    // number packed in the container, and generatePacked reads it without boxing it.
+    // Otherwise generateDatum outputs it as a Datum, which is then converted.
+    llvm::Value *generateDoubleFromMember(ASTNode *parent,
+                                          llvm::Value *isPacked,
+                                          const std::function<llvm::Value *()> &generatePacked,
+                                          const std::function<llvm::Value *()> &generateDatum);
+
     // Convert a double to an int32.
     // Emit return "doesn't like" error if conversion not possible.
     llvm::Value *generateInt32FromDouble(ASTNode *parent, llvm::Value *src, bool isSigned);
@@ -200,6 +229,10 @@ class Compiler
     // Emit return "doesn't like" error if not.
     llvm::Value *generateArrayFromDatum(ASTNode *parent, llvm::Value *src);
 
+    // Validate that Datum is Dictionary.
+    // Emit return "doesn't like" error if not.
+    llvm::Value *generateDictionaryFromDatum(ASTNode *parent, llvm::Value *src);
+
     // Common methodology for the generate*FromDatum() methods.
     llvm::Value *generateFromDatum(Datum::DatumType t, ASTNode *parent, llvm::Value *src);
 
@@ -278,6 +311,15 @@ class Compiler
     // Generate a noop expression.
     llvm::Value *genNoop(const DatumPtr &node, RequestReturnType returnType);
 
+    // Generate a run of FORWARD and BACK moves that were merged by the Logo-level IR.
+    llvm::Value *genMergedForward(const DatumPtr &node, RequestReturnType returnType);
+
+    // Generate a run of RIGHT and LEFT turns that were merged by the Logo-level IR.
+    llvm::Value *genMergedRight(const DatumPtr &node, RequestReturnType returnType);
+
+    // Store the steps of a merged run of turtle moves, its literal children, in an array.
+    llvm::Value *generateStepArray(ASTNode *node, llvm::Value *&count);
+
     // generate the common code for IFTRUE and IFFALSE.
     llvm::Value *generateIftruefalse(const DatumPtr &node, RequestReturnType returnType, bool testForTrue);
 
@@ -287,6 +329,20 @@ class Compiler
     // generate the common code for SETITEM.
     llvm::Value *generateSetitem(const DatumPtr &node, RequestReturnType returnType, bool isDangerous);
 
+    // Generate the name of the property list named by a child, or nullptr if it is a literal.
+    llvm::Value *generatePropertyListName(ASTNode *parent, unsigned int index);
+
+    // Generate the PropertyList named by a child, given the result of generatePropertyListName(),
+    // or nullptr if there is none and isCreating is false. An unpinned PropertyList may be deleted
+    // by REMPROP, so this must come after the other inputs are generated. A literal name of an
+    // existing list, or of any list if isCreating, is resolved at compile time.
+    llvm::Value *generatePropertyList(ASTNode *parent, unsigned int index, llvm::Value *nameValue, bool isCreating);
+
+    // Generate the symbol of the property named by a child, or -1 if there is none and isCreating
+    // is false. A literal name of an existing symbol, or of any symbol if isCreating, is resolved
+    // at compile time.
+    llvm::Value *generatePropertySymbol(ASTNode *parent, unsigned int index, bool isCreating);
+
     // generate the common code for OUTPUT, STOP, and .MAYBEOUTPUT.
     llvm::Value *generateProcedureExit(const DatumPtr &node,
                                        RequestReturnType returnType,
@@ -0,0 +1,159 @@
+#ifndef COMPILER_IR_H
+#define COMPILER_IR_H
+
+//===-- qlogo/compiler_ir.h - Logo-level IR definition -------*- C++ -*-===//
+//
+// Copyright 2017-2024 Jason Sikes
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the conditions specified in the
+// license found in the LICENSE file in the project root.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the declaration of the LogoIR class, a Logo-level
+/// intermediate representation that sits between the AST and the LLVM IR.
+///
+/// The Treeifier produces a list of ASTNode trees, one per instruction. LogoIR
+/// flattens those trees into a numbered (SSA) list of instructions, one for each
+/// ASTNode, where each instruction consumes the values of the instructions that
+/// computed its inputs. This makes Logo-level facts that LLVM cannot see, such
+/// as "this call does not write any variable", available to a handful of cheap
+/// passes. The result is lowered back to ASTNodes which the Compiler then
+/// generates as usual.
+///
+//===----------------------------------------------------------------------===//
+
+#include "datum_ptr.h"
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+
+class ASTNode;
+
+/// @brief A single instruction of the Logo-level IR.
+struct LogoIRInstruction
+{
+    enum Opcode
+    {
+        opLiteral,  // A word, list, or array literal.
+        opVarRead,  // :name
+        opVarWrite, // MAKE "name value
+        opPureCall, // A primitive that neither writes variables nor runs Logo code.
+        opCall,     // Anything else: procedures, RUN, PRINT, LOCAL, etc.
+        opRepeat,   // REPEAT count body
+        opMove,     // FORWARD or BACK
+        opTurn,     // RIGHT or LEFT
+        opTag,      // TAG, a jump target
+    };
+
+    Opcode opcode;
+
+    /// @brief The ASTNode from which this instruction was built.
+    DatumPtr node;
+
+    /// @brief The node that holds this instruction's node as a child, or nullptr if
+    /// this instruction is the root of a statement.
+    ASTNode *parent = nullptr;
+
+    /// @brief The index of this instruction's node within its parent.
+    int childIndex = 0;
+
+    /// @brief The index of the statement within the block that this instruction belongs to.
+    int statement = 0;
+
+    /// @brief The variable name (in key form) for opVarRead and opVarWrite.
+    QString name;
+
+    /// @brief The value numbers of the instructions that compute this instruction's inputs.
+    QList<int> operands;
+
+    /// @brief If not -1, the value number of an earlier opVarRead whose value this read reuses.
+    int replacement = -1;
+
+    /// @brief Set when a pass has removed this instruction's statement.
+    bool isDead = false;
+};
+
+/// @brief A Logo-level IR for one compilation unit, with its optimization passes.
+class LogoIR
+{
+    /// @brief The statements, grouped in the same blocks as the Compiler groups them.
+    QList<QList<DatumPtr>> blocks;
+
+    /// @brief The instructions for each block. Value numbers are unique across all blocks.
+    QList<QList<LogoIRInstruction>> instructions;
+
+    /// @brief The value number of the first instruction in each block.
+    QList<int> blockBase;
+
+    /// @brief The statements of each block that the passes have removed.
+    QList<QSet<int>> deadStatements;
+
+    /// @brief Map from a read that was eliminated to the read whose value it reuses.
+    QHash<const ASTNode *, const ASTNode *> readSources;
+
+    /// @brief The reads whose values are still in use while Logo code may run.
+    QSet<const ASTNode *> pinnedReads;
+
+    int build(int block, int statement, const DatumPtr &node, ASTNode *parent, int childIndex);
+
+    LogoIRInstruction &instructionAt(int valueNumber);
+
+    bool isNumberLiteral(int valueNumber, double &value);
+
+    void replaceNode(int block, LogoIRInstruction &instruction, const DatumPtr &newNode);
+
+    /// @brief Evaluate pure calls whose inputs are all literals, replacing them with the result.
+    void hoistConstantCalls();
+
+    /// @brief Reuse the value of a variable read until something may write to the variable.
+    void eliminateCommonReads();
+
+    /// @brief Remove a MAKE whose value is overwritten before it can be observed.
+    void eliminateDeadMakes();
+
+    /// @brief Combine runs of FORWARD/BACK and RIGHT/LEFT with literal inputs.
+    void mergeTurtleMoves();
+
+    /// @brief Find the reads that must hold a reference to their value, since a later input
+    /// of the same statement may run Logo code that changes the variable.
+    void findPinnedReads();
+
+  public:
+    /// @brief Build the IR from the grouped statements of a compilation unit.
+    /// @param parsedList the statements, grouped into tag and non-tag blocks.
+    LogoIR(const QList<QList<DatumPtr>> &parsedList);
+
+    /// @brief Run all of the optimization passes.
+    void optimize();
+
+    /// @brief Lower the IR back to grouped statements, ready for the Compiler.
+    /// @return The statements that remain after optimization.
+    const QList<QList<DatumPtr>> &lowered() const
+    {
+        return blocks;
+    }
+
+    /// @brief Find the read whose value can be reused in place of the given read.
+    /// @param readNode a genValueOf node.
+    /// @return The earlier genValueOf node, or nullptr if the read must be generated.
+    const ASTNode *sourceOfRead(const ASTNode *readNode) const
+    {
+        return readSources.value(readNode, nullptr);
+    }
+
+    /// @brief Returns true if the value of the given read must be held while it is in use.
+    /// @param readNode a genValueOf node.
+    bool isPinnedRead(const ASTNode *readNode) const
+    {
+        return pinnedReads.contains(readNode);
+    }
+
+    /// @brief Render the IR as text, for debugging.
+    QString toString() const;
+};
+
+#endif // COMPILER_IR_H
@@ -0,0 +1,104 @@
+#ifndef CYCLE_COLLECTOR_H
+#define CYCLE_COLLECTOR_H
+
+//===-- qlogo/cycle_collector.h - CycleCollector class definition -------*- C++ -*-===//
+//
+// Copyright 2017-2024 Jason Sikes
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the conditions specified in the
+// license found in the LICENSE file in the project root.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the declaration of the CycleCollector class, a backup
+/// collector for reference cycles among Lists, Arrays and Dictionaries.
+///
+/// Reference counting frees most data as soon as it is unreachable, but
+/// .SETFIRST, .SETBF, SETITEM and DICTPUT can build containers that refer to
+/// themselves, and those are never freed by reference counting alone. The
+/// collector uses trial deletion (Bacon and Rajan, "Concurrent Cycle Collection
+/// in Reference Counted Systems"): a List, Array or Dictionary that loses a reference but
+/// survives is a suspect. Once enough suspects accumulate, the collector
+/// subtracts the references that suspects and the containers reachable from
+/// them hold on each other. Whatever is left with no outside references is a
+/// garbage cycle and is freed.
+///
+//===----------------------------------------------------------------------===//
+
+#include "datum_core.h"
+#include <QSet>
+#include <cstddef>
+
+/// @brief A trial-deletion collector for reference cycles among Lists, Arrays and Dictionaries.
+class CycleCollector
+{
+    /// @brief The Lists, Arrays and Dictionaries that lost a reference but survived.
+    QSet<Datum *> suspects;
+
+    size_t countOfCollections = 0;
+    size_t countOfObjectsCollected = 0;
+    size_t countOfBytesCollected = 0;
+
+    void addSuspect(Datum *d);
+
+    CycleCollector() = default;
+    ~CycleCollector() = default;
+
+    CycleCollector(const CycleCollector &) = delete;
+    CycleCollector(CycleCollector &&) = delete;
+    CycleCollector &operator=(const CycleCollector &) = delete;
+    CycleCollector &operator=(CycleCollector &&) = delete;
+
+  public:
+    /// @brief Get the singleton instance of the CycleCollector class.
+    /// @return The singleton instance of the CycleCollector class.
+    static CycleCollector &get()
+    {
+        // Never destroyed, since containers may outlive static destruction.
+        static auto *instance = new CycleCollector;
+        return *instance;
+    }
+
+    /// @brief Note that a reference to d was released, but d is still referenced.
+    /// @param d The datum whose retain count was decremented to a non-zero value.
+    static void released(Datum *d)
+    {
+        if (((d->isa == Datum::typeList) || (d->isa == Datum::typeArray) || (d->isa == Datum::typeDictionary)) &&
+            !d->isSuspect)
+            get().addSuspect(d);
+    }
+
+    /// @brief Remove a datum that is being destroyed from the suspects.
+    /// @param d The datum being destroyed.
+    void forget(Datum *d);
+
+    /// @brief Return true if enough suspects have accumulated to run collect().
+    bool isCollectionDue() const;
+
+    /// @brief Find and free the garbage cycles among the suspects.
+    /// @note Only call this where no unretained Datum pointers are live, e.g. when an
+    /// Evaluator has released its temporaries.
+    void collect();
+
+    /// @brief The number of times collect() has run.
+    size_t collections() const
+    {
+        return countOfCollections;
+    }
+
+    /// @brief The number of containers the collector has freed.
+    size_t objectsCollected() const
+    {
+        return countOfObjectsCollected;
+    }
+
+    /// @brief The number of bytes the collector has freed.
+    size_t bytesCollected() const
+    {
+        return countOfBytesCollected;
+    }
+};
+
+#endif // CYCLE_COLLECTOR_H
@@ -7,6 +7,7 @@ class VisitedSet;
 class Word;
 class List;
 class Array;
+struct Dictionary;
 
 /// @brief The unit of data for QLogo. The base class for Word, List, Array, ASTNode, etc.
 class Datum
@@ -37,12 +38,13 @@ private:
     /// @brief Value stored in isa.
     enum DatumType : uint32_t
     {
-        // These are the three data types that are made available to the user.
+        // These are the four data types that are made available to the user.
         typeWord = 0x00000001,
         typeList = 0x00000002,
         typeArray = 0x00000004,
+        typeDictionary = 0x00000008,
         typeEmptyList = 0x00010002,      // Singleton instance of EmptyList
-        typeDataMask = 0x00000007,       // Word + List + Array
+        typeDataMask = 0x0000000F,       // Word + List + Array + Dictionary
         typeWordOrListMask = 0x00000003, // Word + List
         // These are the types that control the flow of the program.
         typeError = 0x00000010,
@@ -61,10 +63,16 @@ private:
 
     DatumType isa = typeNothingPersistent; // Subclasses must set this to a valid value.
 
-    int retainCount = 0;
+    // The retain count and the flags share the word after isa, so that the header is
+    // 16 bytes, vtable pointer included, and subclasses start their fields at offset 16.
+    // They have the same type so that every compiler packs them into one word.
+    quint32 retainCount : 30;
 
     /// @brief If set to 'true', DatumPtr will send qDebug message when this is deleted.
-    bool alertOnDelete = false;
+    quint32 alertOnDelete : 1;
+
+    /// @brief Set while this datum is in the CycleCollector's buffer of suspects.
+    quint32 isSuspect : 1;
 
     /// @brief Get the singleton instance of Datum.
     ///
@@ -78,6 +86,30 @@ private:
     /// @brief Destructor.
     virtual ~Datum();
 
+    /// @brief Delete a datum that is no longer referenced.
+    ///
+    /// @details Deleting a datum releases the datums it refers to. Rather than deleting
+    /// those from inside the destructor, which would use a stack frame for every cell of
+    /// a long list, they are queued and deleted one at a time by the outermost call.
+    static void deleteUnreferenced(Datum *d);
+
+    /// @brief Allocate a Datum (of any subclass) from the DatumPool.
+    static void *operator new(size_t size);
+
+    /// @brief Return a Datum to the DatumPool.
+    /// @note Since the destructor is virtual, size is the size of the most-derived class.
+    static void operator delete(void *p, size_t size);
+
+    /// @brief The number of Datum objects in existence.
+    static int liveNodeCount();
+
+    /// @brief The largest number of Datum objects that have existed at once since
+    /// resetMaxLiveNodeCount() was last called.
+    static int maxLiveNodeCount();
+
+    /// @brief Start tracking the high-water mark of Datum objects from the current count.
+    static void resetMaxLiveNodeCount();
+
     /// @brief This enum specifies flags that can be used to affect various aspects
     /// of the string representation of the Datum.
     enum ToStringFlags : int
@@ -91,6 +123,8 @@ private:
     };
 
     /// @brief Return a string representation of the Datum.
+    /// @details Not virtual: this dispatches on isa to the toString() of the subclass, which
+    /// lets the calls on the common types be made directly.
     /// @param flags Flags to control the output. See ToStringFlags for possible values.
     /// @param printDepthLimit Limit the depth of sublists or arrays for readability.
     /// printDepthLimit = 1 means don't show sublists or arrays.
@@ -100,10 +134,10 @@ private:
     /// @param printWidthLimit Limit the length of a string or list or array for readability.
     /// @param visited Set of visited nodes to prevent cycles.
     /// @return A string representation of the Datum.
-    virtual QString toString(ToStringFlags flags = ToStringFlags_None,
-                             int printDepthLimit = -1,
-                             int printWidthLimit = -1,
-                             VisitedSet *visited = nullptr) const;
+    QString toString(ToStringFlags flags = ToStringFlags_None,
+                     int printDepthLimit = -1,
+                     int printWidthLimit = -1,
+                     VisitedSet *visited = nullptr) const;
 
     /// @brief Returns true if the referred Datum is a List, false otherwise.
     ///
@@ -121,6 +155,14 @@ private:
         return (isa & Datum::typeArray) != 0;
     }
 
+    /// @brief Returns true if the referred Datum is a Dictionary, false otherwise.
+    ///
+    /// @return True if the referred Datum is a Dictionary, false otherwise.
+    bool isDictionary() const
+    {
+        return (isa & Datum::typeDictionary) != 0;
+    }
+
     /// @brief Returns true if the referred Datum is a Word, false otherwise.
     ///
     /// @return True if the referred Datum is a Word, false otherwise.
@@ -188,6 +230,16 @@ private:
         Q_ASSERT(isArray());
         return reinterpret_cast<Array *>(this);
     }
+
+    /// @brief Performs an assertion check that the referred Datum is a Dictionary. Returns a pointer to the referred
+    /// Datum as a Dictionary.
+    ///
+    /// @return A pointer to the referred Datum as a Dictionary.
+    Dictionary *dictionaryValue()
+    {
+        Q_ASSERT(isDictionary());
+        return reinterpret_cast<Dictionary *>(this);
+    }
 };
 
 #endif // DATUM_CORE_H
\ No newline at end of file
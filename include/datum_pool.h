@@ -0,0 +1,149 @@
+#ifndef DATUM_POOL_H
+#define DATUM_POOL_H
+
+//===-- qlogo/datum_pool.h - DatumPool class definition -------*- C++ -*-===//
+//
+// Copyright 2017-2024 Jason Sikes
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the conditions specified in the
+// license found in the LICENSE file in the project root.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the declaration of the DatumPool class, a slab allocator
+/// for Datum objects (Words, Lists, ASTNodes, flow control objects, etc.).
+///
+/// Datum objects are small, numerous, and short-lived. Rather than calling
+/// malloc() and free() for each one, the pool carves objects out of large slabs,
+/// one set of slabs for each size class, and keeps the freed objects of each
+/// slab on a free list for reuse. When every object in a slab has been freed,
+/// the whole slab is returned to the system at once.
+///
+//===----------------------------------------------------------------------===//
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+/// @brief A size-class slab allocator for Datum objects.
+class DatumPool
+{
+    struct FreeCell
+    {
+        FreeCell *next;
+    };
+
+    struct Slab
+    {
+        Slab *prev;
+        Slab *next;
+        Slab *prevInPool;
+        Slab *nextInPool;
+        FreeCell *freeList;
+        char *bump;
+        char *end;
+        uint32_t liveCount;
+        uint32_t sizeClass;
+    };
+
+    /// @brief Slabs are aligned to their size so that an object's slab can be found
+    /// by masking the object's address.
+    static constexpr size_t slabSize = 64 * 1024;
+
+    /// @brief Size classes are multiples of this many bytes.
+    static constexpr size_t granularity = 16;
+
+    /// @brief Objects larger than this are allocated with malloc().
+    static constexpr size_t maxPooledSize = 256;
+
+    static constexpr int countOfSizeClasses = maxPooledSize / granularity;
+
+    /// @brief For each size class, the slabs that have room for at least one more object.
+    Slab *partialSlabs[countOfSizeClasses] = {};
+
+    /// @brief For each size class, the number of slabs currently allocated.
+    int slabsInClass[countOfSizeClasses] = {};
+
+    /// @brief Every slab, full or not, so that the live objects can be enumerated.
+    Slab *allSlabs = nullptr;
+
+    bool isModeSet = false;
+    bool usesSlabs = true;
+
+    size_t bytesInUse = 0;
+    size_t maxBytesInUse = 0;
+    size_t bytesOutsideSlabs = 0;
+    size_t bytesInSlabs = 0;
+
+    Slab *newSlab(int sizeClass);
+    void releaseSlab(Slab *slab);
+    void unlink(Slab *slab);
+    void pushFront(Slab *slab);
+
+    DatumPool() = default;
+    ~DatumPool() = default;
+
+    DatumPool(const DatumPool &) = delete;
+    DatumPool(DatumPool &&) = delete;
+    DatumPool &operator=(const DatumPool &) = delete;
+    DatumPool &operator=(DatumPool &&) = delete;
+
+  public:
+    /// @brief Get the singleton instance of the DatumPool class.
+    /// @return The singleton instance of the DatumPool class.
+    static DatumPool &get()
+    {
+        static DatumPool instance;
+        return instance;
+    }
+
+    /// @brief Allocate memory for a Datum object.
+    /// @param size The size of the object.
+    /// @return A pointer to uninitialized memory of at least the given size.
+    void *allocate(size_t size);
+
+    /// @brief Return the memory of a Datum object to the pool.
+    /// @param p The pointer returned by allocate().
+    /// @param size The size given to allocate().
+    void deallocate(void *p, size_t size);
+
+    /// @brief The number of bytes handed out to Datum objects that have not been freed.
+    size_t countOfBytesInUse() const
+    {
+        return bytesInUse;
+    }
+
+    /// @brief The largest value countOfBytesInUse() has had since resetMaxBytesInUse().
+    size_t maxCountOfBytesInUse() const
+    {
+        return maxBytesInUse;
+    }
+
+    /// @brief Start tracking the high-water mark of bytes in use from the current value.
+    void resetMaxBytesInUse()
+    {
+        maxBytesInUse = bytesInUse;
+    }
+
+    /// @brief Call visit for each object allocated from a slab and not yet freed.
+    /// @param visit Called with the address of the object and the size of its cell.
+    /// @note Objects too large for a slab, or all objects if slabs are disabled, are not
+    /// visited. Their bytes are included in countOfBytesInUse().
+    void forEachLiveObject(const std::function<void(const void *, size_t)> &visit) const;
+
+    /// @brief The number of bytes in use by objects that forEachLiveObject() doesn't visit.
+    size_t countOfBytesOutsideSlabs() const
+    {
+        return bytesOutsideSlabs;
+    }
+
+    /// @brief The number of bytes the pool has reserved from the system for its slabs.
+    size_t countOfBytesInSlabs() const
+    {
+        return bytesInSlabs;
+    }
+};
+
+#endif // DATUM_POOL_H
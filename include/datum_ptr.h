@@ -4,6 +4,7 @@
 #include "datum_core.h"
 #include <QDebug>
 #include <QString>
+#include <cstring>
 
 class Procedure;
 class ASTNode;
@@ -15,10 +16,35 @@ class VisitedSet;
 ///
 /// @details This class is a smart pointer to a Datum. It incorporates convenience
 /// methods, reference-counting, and automatic destruction of the referred datum.
+///
+/// Numbers and booleans are stored in the pointer itself ("NaN-boxing") rather than
+/// in a Word on the heap. Pointers on supported platforms have their top 16 bits
+/// clear; an immediate number is the bit pattern of the double plus 2^48, which
+/// sets at least one of those bits, and an immediate boolean has all of them set.
+/// NaN is not stored as an immediate, so an encoded double never overflows into
+/// the boolean space. An immediate is boxed into a real Word, in place, the first
+/// time a caller asks for a Datum or Word pointer.
 class DatumPtr
 {
   protected:
-    Datum *d;
+    /// @brief Either a Datum pointer or an immediate value.
+    mutable quint64 bits;
+
+    static constexpr quint64 immediateDoubleOffset = 1ULL << 48;
+    static constexpr quint64 immediateBoolTag = 0xFFFF000000000000ULL;
+
+    Datum *pointer() const
+    {
+        return reinterpret_cast<Datum *>(bits);
+    }
+
+    bool isImmediateBool() const
+    {
+        return (bits >> 48) == 0xFFFF;
+    }
+
+    /// @brief Replace an immediate value with a pointer to a new Word holding the same value.
+    void box() const;
 
     void destroy();
 
@@ -26,6 +52,9 @@ class DatumPtr
     /// Copy constructor. Increases retain count of the referred object.
     DatumPtr(const DatumPtr &other) noexcept;
 
+    /// Move constructor. Takes over other's reference, leaving other pointing to nothing.
+    DatumPtr(DatumPtr &&other) noexcept;
+
     /// Default constructor. Creates a pointer to the singleton Datum instance.
     DatumPtr();
 
@@ -46,19 +75,20 @@ class DatumPtr
     /// @brief Convenience constructor for "true" and "false".
     ///
     /// @param b The boolean value to create the DatumPtr for.
-    /// @return A new DatumPtr pointing to a new Word containing the boolean value.
+    /// @return A new DatumPtr holding the boolean value as an immediate.
     explicit DatumPtr(bool b);
 
     /// @brief Convenience constructor for numbers.
     ///
     /// @param n The number to create the DatumPtr for.
-    /// @return A new DatumPtr pointing to a new Word containing the number.
+    /// @return A new DatumPtr holding the number as an immediate, or pointing to a new
+    /// Word if the number is NaN.
     explicit DatumPtr(double n);
 
     /// @brief Convenience constructor for integers.
     ///
     /// @param n The integer to create the DatumPtr for.
-    /// @return A new DatumPtr pointing to a new Word containing the integer.
+    /// @return A new DatumPtr holding the integer as an immediate number.
     explicit DatumPtr(int n);
 
     /// @brief Convenience constructor for strings.
@@ -74,12 +104,39 @@ class DatumPtr
     /// @return A new DatumPtr pointing to a new Word containing the string.
     explicit DatumPtr(const char *n);
 
+    /// @brief Returns true if the value is a number or boolean stored in the pointer itself.
+    bool isImmediate() const
+    {
+        return (bits >> 48) != 0;
+    }
+
+    /// @brief Returns true if the value is a number stored in the pointer itself.
+    bool isImmediateNumber() const
+    {
+        return isImmediate() && !isImmediateBool();
+    }
+
+    /// @brief Returns the value of an immediate number.
+    /// @note Only valid if isImmediateNumber() is true.
+    double immediateNumber() const
+    {
+        quint64 encoded = bits - immediateDoubleOffset;
+        double retval;
+        std::memcpy(&retval, &encoded, sizeof(retval));
+        return retval;
+    }
+
     /// @brief Returns a pointer to the referred Datum or any of Datum's subclasses.
     ///
     /// @return A pointer to the referred Datum or any of Datum's subclasses.
+    /// @note An immediate value is boxed into a Word owned by this DatumPtr, so the
+    /// returned pointer is only valid as long as this DatumPtr (or another reference
+    /// to the Word, such as the Evaluator's release pool) is.
     Datum *datumValue() const
     {
-        return d;
+        if (isImmediate())
+            box();
+        return pointer();
     }
 
     /// @brief Returns a pointer to the referred Datum as a Word.
@@ -107,6 +164,11 @@ class DatumPtr
     /// @return A pointer to the referred Datum as an Array.
     Array *arrayValue() const;
 
+    /// @brief Returns a pointer to the referred Datum as a Dictionary.
+    ///
+    /// @return A pointer to the referred Datum as a Dictionary.
+    Dictionary *dictionaryValue() const;
+
     /// @brief Returns a pointer to the referred Datum as a FlowControl.
     ///
     /// @return A pointer to the referred Datum as a FlowControl.
@@ -122,7 +184,7 @@ class DatumPtr
     /// @return True if the referred Datum is a Word, false otherwise.
     bool isWord() const
     {
-        return d->isa == Datum::typeWord;
+        return isImmediate() || (pointer()->isa == Datum::typeWord);
     }
 
     /// @brief Returns true if the referred Datum is a List, false otherwise.
@@ -130,7 +192,7 @@ class DatumPtr
     /// @return True if the referred Datum is a List, false otherwise.
     bool isList() const
     {
-        return (d->isa & Datum::typeList) != 0;
+        return !isImmediate() && ((pointer()->isa & Datum::typeList) != 0);
     }
 
     /// @brief Returns true if the referred Datum is an ASTNode, false otherwise.
@@ -138,7 +200,7 @@ class DatumPtr
     /// @return True if the referred Datum is an ASTNode, false otherwise.
     bool isASTNode() const
     {
-        return d->isa == Datum::typeASTNode;
+        return !isImmediate() && (pointer()->isa == Datum::typeASTNode);
     }
 
     /// @brief Returns true if the referred Datum is an Array, false otherwise.
@@ -146,7 +208,15 @@ class DatumPtr
     /// @return True if the referred Datum is an Array, false otherwise.
     bool isArray() const
     {
-        return d->isa == Datum::typeArray;
+        return !isImmediate() && (pointer()->isa == Datum::typeArray);
+    }
+
+    /// @brief Returns true if the referred Datum is a Dictionary, false otherwise.
+    ///
+    /// @return True if the referred Datum is a Dictionary, false otherwise.
+    bool isDictionary() const
+    {
+        return !isImmediate() && (pointer()->isa == Datum::typeDictionary);
     }
 
     /// @brief Returns true if the referred Datum is an Err, false otherwise.
@@ -154,7 +224,7 @@ class DatumPtr
     /// @return True if the referred Datum is an Err, false otherwise.
     bool isErr() const
     {
-        return d->isa == Datum::typeError;
+        return !isImmediate() && (pointer()->isa == Datum::typeError);
     }
 
     /// @brief Returns true if the referred Datum is the singleton Datum instance, false otherwise.
@@ -162,7 +232,7 @@ class DatumPtr
     /// @return True if the referred Datum is the singleton Datum instance, false otherwise.
     bool isNothing() const
     {
-        return d == Datum::notADatum();
+        return pointer() == Datum::notADatum();
     }
 
     /// @brief Returns true if the referred Datum is a FlowControl, false otherwise.
@@ -170,7 +240,7 @@ class DatumPtr
     /// @return True if the referred Datum is a FlowControl, false otherwise.
     bool isFlowControl() const
     {
-        return (d->isa & Datum::typeFlowControlMask) != 0;
+        return !isImmediate() && ((pointer()->isa & Datum::typeFlowControlMask) != 0);
     }
 
     /// @brief Reassign the pointer to refer to the other object.
@@ -179,10 +249,17 @@ class DatumPtr
     /// @return A reference to this.
     DatumPtr &operator=(const DatumPtr &other) noexcept;
 
+    /// @brief Take over the reference held by other, leaving other pointing to nothing.
+    ///
+    /// @param other The DatumPtr to move into this.
+    /// @return A reference to this.
+    DatumPtr &operator=(DatumPtr &&other) noexcept;
+
     /// @brief Return true if and only if other points to the same object as this.
     ///
     /// @param other The DatumPtr to compare to this.
-    /// @return True if and only if other points to the same object as this.
+    /// @return True if and only if other points to the same object as this, or both
+    /// hold the same immediate value.
     bool operator==(const DatumPtr &other) const;
 
     /// @brief Return true if and only if other does not point to the same object as this.
@@ -211,7 +288,7 @@ class DatumPtr
     /// @return The DatumType of the referenced object.
     Datum::DatumType isa() const
     {
-        return d->isa;
+        return isImmediate() ? Datum::typeWord : pointer()->isa;
     }
 
     /// @brief Set a mark on the datum so that debug message will print when datum is
@@ -221,6 +298,7 @@ class DatumPtr
     /// a mark on the datum so that a debug message will be printed when the datum is destroyed.
     void alertOnDelete()
     {
+        Datum *d = datumValue();
         qDebug() << "MARKED: " << d << " " << d->toString(Datum::ToStringFlags_Show);
         d->alertOnDelete = true;
     }
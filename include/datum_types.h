@@ -3,7 +3,9 @@
 
 #include "datum_ptr.h"
 #include <QList>
+#include <QHash>
 #include <QString>
+#include <utility>
 
 class ListIterator;
 class VisitedSet;
@@ -26,33 +28,106 @@ void rawToChar(QString &src);
 /// Words that are initially defined as strings may be parsed as numbers.
 ///
 /// e.g. "SUM WORD 3 4 2" outputs "36".
-class Word : public Datum
+///
+/// To keep words small, a word created with a number stores only the number until its
+/// string form is needed, and short strings are stored inside the word itself. The key
+/// (uppercase) and printable forms are generated on demand, and only stored (in a
+/// shared cache) when they differ from the raw string. The key of an interned word,
+/// which is a name in source text, is always stored, since names are looked up often.
+class Word final : public Datum
 {
-  protected:
-    mutable QString rawString;
-    mutable QString keyString;
-    mutable QString printableString;
-    mutable double number;
-    mutable bool boolean;
-    bool sourceIsNumber;
-
-    void genRawString() const;
-    void genPrintString() const;
-    void genKeyString() const;
-
   public:
     /// @brief Set to true if the word was created with vertical bars as delimiters.
     /// Words created this way will not be separated during parsing or runparsing.
-    bool isForeverSpecial;
+    bool isForeverSpecial : 1;
 
     /// @brief True if a number was calculated/given AND the number is valid
     /// @note Read this AFTER calling numberValue()
-    mutable bool numberIsValid = false;
+    mutable bool numberIsValid : 1;
 
     /// @brief True if the word is either "true" or "false".
     /// @note Read this AFTER calling boolValue()
-    mutable bool boolIsValid = false;
+    mutable bool boolIsValid : 1;
+
+  protected:
+    /// @brief Strings of up to this many UTF-16 code units are stored inside the Word.
+    static constexpr int inlineCapacity = 8;
+
+    /// @brief Latin-1 strings of up to this many characters are stored inside the Word,
+    /// one byte per character.
+    static constexpr int inlineLatin1Capacity = 16;
+
+    // Along with the public flags above, these are packed into the bytes between the
+    // Datum header and number.
+    bool sourceIsNumber : 1;
+    mutable bool boolean : 1;
+    mutable bool hasString : 1;       // The raw string has been given or generated.
+    mutable bool isInline : 1;        // The raw string is stored in inlineChars or inlineLatin1.
+    mutable bool isLatin1 : 1;        // The inline string is stored in inlineLatin1.
+    mutable bool printableIsRaw : 1;  // The printable form has been generated and is the same as the raw form.
+    mutable bool keyIsRaw : 1;        // The key form has been generated and is the same as the raw form.
+    mutable bool hasCachedForms : 1;  // This word has an entry in the shared form cache.
+    // Each interpretation of the word is unknown until first asked for, and then remembered
+    // whether or not the word turned out to be a number (or a boolean).
+    mutable bool hasParsedNumber : 1; // number and numberIsValid are up to date.
+    mutable bool hasParsedBool : 1;   // boolean and boolIsValid are up to date.
+    bool isInterned : 1;              // This word is the entry for its string in the intern table.
+    mutable quint8 inlineLength;
+
+    // The index of the key form of an interned word in the shared key table, or 0 if it
+    // hasn't been asked for. It fits in the padding before number.
+    mutable quint32 keyIndex;
+
+    mutable double number;
+
+    /// @brief The buffer of a longer raw string, shared by the words sliced from it and the
+    /// words appended to it. Each word sees only its own slice, so characters may be added
+    /// past the end of every slice without changing any word that shares the buffer.
+    struct SharedText
+    {
+        QString string;
+        quint32 refCount;
+    };
+
+    /// @brief A longer raw string is the slice [start, start + length) of a SharedText.
+    struct HeapText
+    {
+        SharedText *text;
+        quint32 start;
+        quint32 length;
+    };
+
+    union {
+        mutable HeapText heap;
+        mutable char16_t inlineChars[inlineCapacity];
+        mutable char inlineLatin1[inlineLatin1Capacity];
+    };
+
+    void setRawString(const QString &src) const;
+    void generateRawString() const;
+    void releaseText() const;
+    void appendRawTo(QString &dest) const;
+    QString rawString() const;
+    QString printableString() const;
+    QString keyString() const;
+    QString generateKeyString() const;
+    const QString *printableForm() const;
+    const QString *keyForm() const;
+
+    /// @brief Calls f with a view of the raw string, which is a QLatin1StringView or a
+    /// QStringView, depending on how the string is stored.
+    template <typename F> decltype(auto) withRawView(F &&f) const
+    {
+        if (!hasString)
+            generateRawString();
+        if (isLatin1)
+            return f(QLatin1StringView(inlineLatin1, inlineLength));
+        if (isInline)
+            return f(QStringView(inlineChars, inlineLength));
+        return f(QStringView(heap.text->string).sliced(heap.start, heap.length));
+    }
 
+  public:
     /// @brief Create a Word object that is invalid.
     Word();
 
@@ -81,7 +156,40 @@ class Word : public Datum
     QString toString(Datum::ToStringFlags flags = Datum::ToStringFlags_None,
                      int printDepthLimit = -1,
                      int printWidthLimit = -1,
-                     VisitedSet *visited = nullptr) const override;
+                     VisitedSet *visited = nullptr) const;
+
+    /// @brief Returns the word holding the given raw string, creating it if there is none.
+    ///
+    /// @details The parser interns the words of source text, so each name and literal is
+    /// stored once however often it appears, and two occurrences of it are the same object.
+    /// The table doesn't retain its words; a word leaves the table when it is destroyed.
+    /// @param raw The raw string of the word.
+    /// @param aIsForeverSpecial True if the word was written with vertical bars.
+    static Word *intern(const QString &raw, bool aIsForeverSpecial = false);
+
+    /// @brief Returns the number of characters in the raw string of the word.
+    qsizetype rawLength() const;
+
+    /// @brief Returns the character of the raw string at index.
+    /// @param index The index of the character, from 0 to rawLength() - 1.
+    QChar rawCharAt(qsizetype index) const;
+
+    /// @brief Returns a new Word holding part of this word's raw string.
+    ///
+    /// @param start The index of the first character of the slice.
+    /// @param length The number of characters in the slice.
+    /// @return A new Word. A long slice shares this word's buffer instead of copying it, so
+    /// taking BUTFIRST of a word repeatedly costs O(1) per step.
+    Word *slice(qsizetype start, qsizetype length) const;
+
+    /// @brief Returns a new Word holding the raw strings of words, one after another.
+    ///
+    /// @param words The words to concatenate.
+    /// @param count The number of words.
+    /// @return A new Word. If the first word's slice ends at the end of its buffer, the
+    /// other words are appended to that buffer and the new word shares it, so building a
+    /// word with repeated WORD or LPUT costs amortized O(1) per character added.
+    static Word *concatenate(const Word *const *words, qsizetype count);
 
     /// @brief Return true iff this word was created with a number.
     ///
@@ -90,12 +198,59 @@ class Word : public Datum
     {
         return sourceIsNumber;
     }
+
+    /// @brief Calls f with a view of the printable form of the word, without copying a
+    /// string that is stored inside the word. The view is only valid during the call.
+    /// @param f A callable that accepts either a QLatin1StringView or a QStringView.
+    template <typename F> decltype(auto) withPrintableView(F &&f) const
+    {
+        const QString *form = printableForm();
+        if (form == nullptr)
+            return withRawView(f);
+        return f(QStringView(*form));
+    }
+
+    /// @brief Calls f with a view of the key (uppercase) form of the word, without copying
+    /// a string that is stored inside the word. The view is only valid during the call.
+    /// @param f A callable that accepts either a QLatin1StringView or a QStringView.
+    template <typename F> decltype(auto) withKeyView(F &&f) const
+    {
+        const QString *form = keyForm();
+        if (form == nullptr)
+            return withRawView(f);
+        return f(QStringView(*form));
+    }
+
+    /// @brief Returns a hash of the word that is the same for any two words that are
+    /// EQUALP, whether or not CASEIGNOREDP is set.
+    quint32 structuralHash() const;
+
+    /// @brief Format a number the way Logo prints it, which is QString::number(n), i.e.
+    /// printf("%.6g"), but without going through QLocale.
+    static QString formatNumber(double n);
+
+    /// @brief Parse a number, accepting exactly what QString::toDouble() accepts.
+    /// @param s The text to parse.
+    /// @param isValid Set to true iff s is a valid number.
+    /// @return The value of s, or 0 if s isn't a number.
+    static double parseNumber(QStringView s, bool *isValid);
+
+    /// @brief Returns the structural hash of a word whose number value is n.
+    static quint32 hashOfNumber(double n);
+
+    /// @brief Returns the structural hash of a word that isn't a number.
+    /// @param s The printable form of the word.
+    static quint32 hashOfString(const QString &s);
 };
 
 /// @brief The container that allows efficient read and write access to its elements.
-struct Array : public Datum
+struct Array final : public Datum
 {
     /// @brief The container that stores the elements of the Array.
+    ///
+    /// @details Numbers stored by SETITEM are held as immediates (see DatumPtr), so an
+    /// array of numbers takes eight bytes per element and no Words. Reading an element
+    /// with ITEM doesn't box it in place, so the array stays packed.
     QList<DatumPtr> array;
 
     /// @brief Create an Array containing aSize empty List with starting index at aOrigin.
@@ -116,12 +271,82 @@ struct Array : public Datum
     QString toString(Datum::ToStringFlags flags = Datum::ToStringFlags_None,
                      int printDepthLimit = -1,
                      int printWidthLimit = -1,
-                     VisitedSet *visited = nullptr) const override;
+                     VisitedSet *visited = nullptr) const;
 
     /// @brief The starting index of this Array.
     int origin = 1;
 };
 
+/// @brief A hash table from keys to values.
+///
+/// @details Keys are compared as EQUALP compares them, so two keys are the same if they
+/// are equal words (respecting CASEIGNOREDP), equal lists, or the same array or
+/// dictionary. Keys are bucketed by their structural hash, which is the same for any
+/// two keys that could be equal, so a lookup only compares the key with the few keys
+/// that share its hash. A list that is changed in place after it was used as a key
+/// may no longer be found.
+struct Dictionary final : public Datum
+{
+    struct Entry
+    {
+        DatumPtr key;
+        DatumPtr value;
+        quint32 hash;
+    };
+
+    /// @brief The entries, in the order their keys were first added. The key of a
+    /// removed entry is nothing until the entries are compacted.
+    QList<Entry> entries;
+
+    /// @brief The index in entries of each entry, keyed by the structural hash of its key.
+    QMultiHash<quint32, qsizetype> indexesByHash;
+
+    /// @brief The number of removed entries still in entries.
+    qsizetype countOfRemoved = 0;
+
+    /// @brief Create an empty Dictionary.
+    Dictionary();
+
+    /// @brief Destructor.
+    ~Dictionary() override;
+
+    QString toString(Datum::ToStringFlags flags = Datum::ToStringFlags_None,
+                     int printDepthLimit = -1,
+                     int printWidthLimit = -1,
+                     VisitedSet *visited = nullptr) const;
+
+    /// @brief The number of keys in the dictionary.
+    qsizetype count() const
+    {
+        return entries.size() - countOfRemoved;
+    }
+
+    /// @brief Find the entry of a key.
+    /// @param key The key to find.
+    /// @param hash The structural hash of key.
+    /// @param isEqual Called with a key of the dictionary and key; returns true if they are equal.
+    /// @return The index in entries of the key's entry, or -1 if there is none.
+    template <typename Equal> qsizetype indexOf(const DatumPtr &key, quint32 hash, Equal isEqual) const
+    {
+        auto [begin, end] = indexesByHash.equal_range(hash);
+        for (auto it = begin; it != end; ++it)
+        {
+            if (isEqual(entries[*it].key, key))
+                return *it;
+        }
+        return -1;
+    }
+
+    /// @brief Add an entry for a key that isn't in the dictionary.
+    void insert(const DatumPtr &key, quint32 hash, const DatumPtr &value);
+
+    /// @brief Remove the entry at index, as returned by indexOf().
+    void removeAt(qsizetype index);
+
+    /// @brief Remove every entry.
+    void clear();
+};
+
 /// @brief The general container for data. The QLogo List is implemented as a linked list.
 ///
 /// @details The List class is a linked list of DatumPtrs. The head of the list must contain a
@@ -132,6 +357,35 @@ class List : public Datum
     friend class ListIterator;
     friend class Compiler;
 
+    /// @brief Incremented whenever an existing list cell that may be shared is modified,
+    /// which invalidates every cached count and hash. It starts at 1, so that the epoch of
+    /// a new cell never matches, and is too wide to wrap around to an epoch that a cell
+    /// still holds.
+    static quint64 structureEpoch;
+
+    // The count, last cell and structural hash of the list starting at this cell are
+    // cached, and are valid only while cacheEpoch matches structureEpoch. hasCachedHash,
+    // isKnownUnique, hasStaleCells and cacheEpoch share the word between the Datum header
+    // and head.
+    mutable quint64 hasCachedHash : 1;
+
+    // Set when each later cell of the list was found to be referenced only by the cell
+    // before it. Cleared whenever one of those cells may be handed out.
+    mutable quint64 isKnownUnique : 1;
+
+    // Set when a unique list was changed in place. The caches of its later cells may be
+    // stale, but nothing else can reach those cells, so they are cleared only before one
+    // of them is handed out or the list is hashed.
+    mutable quint64 hasStaleCells : 1;
+
+    mutable quint64 cacheEpoch : 61;
+
+    int countWithCycle() const;
+    void clearStaleCells() const;
+
+    quint32 hashOfCells(int *budget) const;
+    static quint32 hashOfElement(const DatumPtr &element, int &budget);
+
   public:
     /// @brief The head of the list, also called the 'element'.
     ///
@@ -148,31 +402,119 @@ class List : public Datum
     /// Set to one when the list is modified to trigger recompilation, if needed.
     qint64 compileTimeStamp = 0;
 
+  protected:
+    mutable const List *cachedLast = nullptr;
+    mutable int cachedCount = 0;
+    mutable quint32 cachedHash = 0;
+
+  public:
     /// @brief Create a new list by attaching item as the head of srcList.
     ///
     /// @param item The item to add to the head of the list.
     /// @param srcList The list to copy from, this will become the tail of the new list.
     List(const DatumPtr &item, List *srcList);
 
+    /// @brief Create a new list by attaching item as the head of srcList.
+    ///
+    /// @param item The item to move into the head of the list.
+    /// @param srcList The list to copy from, this will become the tail of the new list.
+    List(DatumPtr &&item, List *srcList);
+
     /// @brief Destructor.
     ~List() override;
 
     QString toString(ToStringFlags flags = ToStringFlags_None,
                      int printDepthLimit = -1,
                      int printWidthLimit = -1,
-                     VisitedSet *visited = nullptr) const override;
+                     VisitedSet *visited = nullptr) const;
 
     /// @brief Empty the List
     void clear();
 
     /// @brief Returns the count of elements in the List.
     ///
-    /// @details This should only be used when you need a specfic number since it traverses
-    /// the list. Consider using isEmpty().
+    /// @details The first call traverses the list and caches the count in each cell, so
+    /// later calls on the list or any of its BUTFIRSTs are constant time until a list
+    /// tail is modified.
     ///
     /// @return The count of elements in the List.
     int count() const;
 
+    /// @brief Returns the last cell of the List.
+    ///
+    /// @return The last cell of the List, or nullptr if the List is empty or circular.
+    const List *lastCell() const;
+
+    /// @brief Record the count and last cell of a list that was just built.
+    ///
+    /// @param aCount The count of elements in the list starting at this cell.
+    /// @param aLast The last cell of the list.
+    void cacheCount(int aCount, const List *aLast) const
+    {
+        cachedCount = aCount;
+        cachedLast = aLast;
+        cacheEpoch = structureEpoch;
+        hasCachedHash = false;
+    }
+
+    /// @brief Invalidate all cached counts and hashes. Call this after replacing the head
+    /// or tail of a list cell that may have been counted or hashed.
+    static void structureDidChange()
+    {
+        ++structureEpoch;
+    }
+
+    /// @brief Invalidate the cached counts and hashes of this list only. Call this instead of
+    /// structureDidChange() after changing a list that isUnique(), since no other list can
+    /// reach its cells.
+    void cellsDidChange() const
+    {
+        cacheEpoch = 0;
+        hasCachedHash = false;
+        hasStaleCells = true;
+    }
+
+    /// @brief Returns true if this list is referenced exactly holders times, and each of its
+    /// later cells only by the cell before it.
+    ///
+    /// @details Such a list, when it is the value of a variable, can be changed in place
+    /// by a MAKE that assigns the changed list back to that variable. The holder is then
+    /// the variable; any other reference, including a read that is pinned because Logo
+    /// code runs while it is still in use, rules the change out. The walk that
+    /// checks the later cells is remembered until one of them is handed out, e.g. by BUTFIRST.
+    /// @param holders The number of references that are known to be accounted for.
+    bool isUnique(int holders) const;
+
+    /// @brief Note that a reference to one of the later cells of this list is being handed out.
+    void cellsWereShared() const
+    {
+        isKnownUnique = false;
+        if (hasStaleCells)
+            clearStaleCells();
+    }
+
+    /// @brief Attach a list to the end of this one, in place. Only call this if isUnique()
+    /// is true.
+    /// @param aList The list to attach. Its cells must not be referenced by anything else.
+    void appendInPlace(const DatumPtr &aList);
+
+    /// @brief Remove the last member of this list, in place. Only call this if isUnique()
+    /// is true and the list has at least two members.
+    void removeLastInPlace();
+
+    /// @brief Returns a hash of the List that is the same for any two lists that are
+    /// EQUALP, whether or not CASEIGNOREDP is set. Lists whose hashes differ are not equal.
+    ///
+    /// @details Like the count, the hash of each cell that is walked is cached until a list
+    /// is modified. Sublists only contribute their first few hundred members to the hash,
+    /// so that a list that contains itself can be hashed.
+    quint32 structuralHash() const;
+
+    /// @brief Returns the structural hash of a Word, List or Array.
+    ///
+    /// @details An Array is only equal to itself, so its hash is that of its address.
+    static quint32 structuralHashOf(const DatumPtr &element);
+
     /// @brief Returns the element pointed to by anIndex.
     ///
     /// @param anIndex The index of the element to return.
@@ -227,7 +569,7 @@ class EmptyList : public List
     QString toString(ToStringFlags flags = ToStringFlags_None,
                      int printDepthLimit = -1,
                      int printWidthLimit = -1,
-                     VisitedSet *visited = nullptr) const override;
+                     VisitedSet *visited = nullptr) const;
 };
 
 /// @brief A class that simplifies iterating through a list.
@@ -254,6 +596,19 @@ class ListIterator
     /// @return The element at the current location.
     DatumPtr element();
 
+    /// @brief Return the element at the current location without retaining it. Advance
+    /// Iterator to the next location.
+    ///
+    /// @return The element at the current location. The reference is valid only as long
+    /// as the list is neither changed nor released.
+    /// @note Asking the element for its Datum boxes an immediate number inside the list.
+    const DatumPtr &borrowElement()
+    {
+        const DatumPtr &retval = iterator->head;
+        iterator = iterator->tail.listValue();
+        return retval;
+    }
+
     /// @brief Returns true if pointer references a valid element.
     bool elementExists() const;
 };
@@ -266,6 +621,8 @@ class ListBuilder
 {
   private:
     DatumPtr finishedList_;
+    int countOfElements = 0;
+    mutable bool isFinishedListShared = false;
 
   public:
     List *firstNode;
@@ -280,7 +637,19 @@ class ListBuilder
     /// @param element The element to append to the end of the list.
     void append(const DatumPtr &element)
     {
-        List *newList = new List(element, EmptyList::instance());
+        appendCell(new List(element, EmptyList::instance()));
+    }
+
+    /// @brief Append an element to the end of the list.
+    /// @param element The element to move to the end of the list.
+    void append(DatumPtr &&element)
+    {
+        appendCell(new List(std::move(element), EmptyList::instance()));
+    }
+
+  private:
+    void appendCell(List *newList)
+    {
         if (firstNode == EmptyList::instance())
         {
             firstNode = newList;
@@ -289,15 +658,31 @@ class ListBuilder
         }
         else
         {
+            // Once the list has been handed out its cells may have cached counts. If the
+            // builder still holds the only reference, only those counts are stale.
+            if (isFinishedListShared)
+            {
+                if (firstNode->isUnique(1))
+                    firstNode->cellsDidChange();
+                else
+                    List::structureDidChange();
+            }
             lastNode->tail = DatumPtr(newList);
             lastNode = newList;
         }
+        ++countOfElements;
     }
 
+  public:
     /// @brief Return the finished list.
     /// @return The finished list.
     DatumPtr finishedList() const
     {
+        if (firstNode != EmptyList::instance())
+        {
+            firstNode->cacheCount(countOfElements, lastNode);
+            isFinishedListShared = true;
+        }
         return finishedList_;
     }
 };
@@ -386,7 +386,7 @@ struct FCError : public FlowControl
     QString toString(ToStringFlags flags = ToStringFlags_None,
                      int printDepthLimit = -1,
                      int printWidthLimit = -1,
-                     VisitedSet *visited = nullptr) const override;
+                     VisitedSet *visited = nullptr) const;
 };
 
 #endif // FLOWCONTROL_H
@@ -73,6 +73,7 @@ llvm::Value *genSentence(const DatumPtr &node, RequestReturnType returnType);
 llvm::Value *genFput(const DatumPtr &node, RequestReturnType returnType);
 llvm::Value *genLput(const DatumPtr &node, RequestReturnType returnType);
 llvm::Value *genArray(const DatumPtr &node, RequestReturnType returnType);
+llvm::Value *genMdarray(const DatumPtr &node, RequestReturnType returnType);
 llvm::Value *genListtoarray(const DatumPtr &node, RequestReturnType returnType);
 llvm::Value *genArraytolist(const DatumPtr &node, RequestReturnType returnType);
 llvm::Value *genFirst(const DatumPtr &node, RequestReturnType returnType);
@@ -80,7 +81,9 @@ llvm::Value *genLast(const DatumPtr &node, RequestReturnType returnType);
 llvm::Value *genButfirst(const DatumPtr &node, RequestReturnType returnType);
 llvm::Value *genButlast(const DatumPtr &node, RequestReturnType returnType);
 llvm::Value *genItem(const DatumPtr &node, RequestReturnType returnType);
+llvm::Value *genMditem(const DatumPtr &node, RequestReturnType returnType);
 llvm::Value *genSetitem(const DatumPtr &node, RequestReturnType returnType);
+llvm::Value *genMdsetitem(const DatumPtr &node, RequestReturnType returnType);
 llvm::Value *genDotSetitem(const DatumPtr &node, RequestReturnType returnType);
 llvm::Value *genDotSetfirst(const DatumPtr &node, RequestReturnType returnType);
 llvm::Value *genDotSetbf(const DatumPtr &node, RequestReturnType returnType);
@@ -99,11 +102,18 @@ llvm::Value *genAscii(const DatumPtr &node, RequestReturnType returnType);
 llvm::Value *genRawascii(const DatumPtr &node, RequestReturnType returnType);
 llvm::Value *genChar(const DatumPtr &node, RequestReturnType returnType);
 llvm::Value *genMember(const DatumPtr &node, RequestReturnType returnType);
+llvm::Value *genRemdup(const DatumPtr &node, RequestReturnType returnType);
 llvm::Value *genLowercase(const DatumPtr &node, RequestReturnType returnType);
 llvm::Value *genUppercase(const DatumPtr &node, RequestReturnType returnType);
 llvm::Value *genStandout(const DatumPtr &node, RequestReturnType returnType);
 llvm::Value *genParse(const DatumPtr &node, RequestReturnType returnType);
 llvm::Value *genRunparse(const DatumPtr &node, RequestReturnType returnType);
+llvm::Value *genDictionary(const DatumPtr &node, RequestReturnType returnType);
+llvm::Value *genDictput(const DatumPtr &node, RequestReturnType returnType);
+llvm::Value *genDictget(const DatumPtr &node, RequestReturnType returnType);
+llvm::Value *genDictremove(const DatumPtr &node, RequestReturnType returnType);
+llvm::Value *genDictkeys(const DatumPtr &node, RequestReturnType returnType);
+llvm::Value *genDictionaryp(const DatumPtr &node, RequestReturnType returnType);
 llvm::Value *genForward(const DatumPtr &node, RequestReturnType returnType);
 llvm::Value *genBack(const DatumPtr &node, RequestReturnType returnType);
 llvm::Value *genLeft(const DatumPtr &node, RequestReturnType returnType);
@@ -165,4 +175,13 @@ llvm::Value *genButton(const DatumPtr &node, RequestReturnType returnType);
 llvm::Value *genInputProcedure(const DatumPtr &node, RequestReturnType returnType);
 llvm::Value *genMake(const DatumPtr &node, RequestReturnType returnType);
 llvm::Value *genLocal(const DatumPtr &node, RequestReturnType returnType);
+llvm::Value *genPprop(const DatumPtr &node, RequestReturnType returnType);
+llvm::Value *genGprop(const DatumPtr &node, RequestReturnType returnType);
+llvm::Value *genRemprop(const DatumPtr &node, RequestReturnType returnType);
+llvm::Value *genPlist(const DatumPtr &node, RequestReturnType returnType);
+llvm::Value *genPlistp(const DatumPtr &node, RequestReturnType returnType);
+llvm::Value *genNodes(const DatumPtr &node, RequestReturnType returnType);
+llvm::Value *genHeapstats(const DatumPtr &node, RequestReturnType returnType);
+llvm::Value *genHeapsnapshot(const DatumPtr &node, RequestReturnType returnType);
+llvm::Value *genAllocations(const DatumPtr &node, RequestReturnType returnType);
 #endif // PRIMITIVE_HEADER_H
@@ -175,6 +175,9 @@ const bool debugBuild = false;
     // Set to true iff compiler should show the CFG view.
     bool showCFG = false;
 
+    // Set to true iff compiler should show the Logo-level IR after its passes.
+    bool showLIR = false;
+
     // Set to true if Compiler should verify the generated functions.
     // Use for development. Compiler may generate bad code in unreachable
     // sections, i.e. when handling parsing errors.
@@ -184,6 +187,21 @@ const bool debugBuild = false;
     // Set to true iff compiler should show the CFG view.
     bool showCON = false;
 
+    // Set to true iff Datum objects are allocated from slabs rather than with malloc().
+    // Must be set before the first Datum is allocated.
+    bool useSlabAllocator = true;
+
+    // The number of suspected garbage cycles (lists or arrays that lost a reference but
+    // are still referenced) that triggers the cycle collector. Zero disables it.
+    int cycleCollectorThreshold = 10000;
+
+    // Set to true iff the cycle collector should report each collection.
+    bool showGC = false;
+
+    // Set to true iff the compiler should instrument code so that the AllocationProfiler
+    // can attribute allocations to instructions.
+    bool profileAllocations = false;
+
     // ARGV initialization parameters
     QStringList ARGV;
 
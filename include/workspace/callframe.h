@@ -47,10 +47,14 @@ struct CallFrameStack
     /// @brief Repcount is for use in looping functions (e.g. REPEAT)
     double repcount = -1;
 
+    /// @brief True while caseIgnored holds the value of CASEIGNOREDP.
+    mutable bool isCaseIgnoredCached = false;
+    mutable bool caseIgnored = false;
+
     /// @brief Return the value of a variable.
     /// @param name The name of the variable to search for.
     /// @return The stored value associated with 'name' or 'nothing' if the variable is not found.
-    DatumPtr datumForName(const QString &name) const;
+    const DatumPtr &datumForName(const QString &name) const;
 
     /// @brief Set a value for a variable.
     /// @param aDatum The value to store.
@@ -66,6 +70,11 @@ struct CallFrameStack
     /// @param name The name of the variable to erase.
     void eraseVar(const QString &name);
 
+    /// @brief Return true if the variable CASEIGNOREDP is TRUE.
+    /// @details Word comparisons ask for this constantly, so the value is cached until
+    /// CASEIGNOREDP is set or erased.
+    bool isCaseIgnored() const;
+
     /// @brief Returns the size of the stack, i.e. the number of stack frames.
     /// @return The size of the stack.
     int size() const
@@ -266,8 +275,17 @@ struct Evaluator
     /// @brief The return value of this evaluation.
     Datum *retval = nullptr;
 
-    /// @brief A pool of objects for garbage collection.
-    QList<Datum *> releasePool;
+    /// @brief The objects watched by all Evaluators, for garbage collection.
+    ///
+    /// @details Evaluators are strictly nested, so rather than each keeping its own
+    /// list, they share one stack. An Evaluator owns the entries from releasePoolBase
+    /// to the top, and on destruction it releases them and drops them from the stack in
+    /// a single step. The stack keeps its capacity, so once it has grown to the deepest
+    /// use, creating an Evaluator and watching temporaries never allocates.
+    static QList<Datum *> releasePool;
+
+    /// @brief The index of this Evaluator's first entry in the releasePool.
+    qsizetype releasePoolBase;
 
     /// @brief Constructor.
     /// @param aList The list to evaluate.
@@ -22,12 +22,14 @@ EXPORTC double getDoubleForDatum(addr_t eAddr, addr_t datumAddr);
 EXPORTC bool getValidityOfDoubleForDatum(addr_t eAddr, addr_t datumAddr);
 EXPORTC bool getBoolForDatum(addr_t eAddr, addr_t datumAddr);
 EXPORTC bool getValidityOfBoolForDatum(addr_t eAddr, addr_t datumAddr);
-EXPORTC addr_t getDatumForVarname(addr_t wordAddr);
+EXPORTC addr_t getDatumForVarname(addr_t eAddr, addr_t wordAddr);
+EXPORTC addr_t pinDatum(addr_t eAddr, addr_t datumAddr);
 EXPORTC addr_t stdWriteDatum(addr_t datumAddr, bool useShow);
 EXPORTC addr_t stdWriteDatumAry(addr_t datumAddr, uint32_t count, bool useShow, bool addWhitespace);
 EXPORTC addr_t getWordForDouble(addr_t eAddr, double val);
 EXPORTC addr_t getWordForBool(addr_t eAddr, bool val);
 EXPORTC void setDatumForWord(addr_t datumAddr, addr_t wordAddr);
+EXPORTC void setDoubleForWord(double val, addr_t wordAddr);
 EXPORTC addr_t runList(addr_t eAddr, addr_t listAddr);
 EXPORTC addr_t runProcedure(addr_t eAddr, addr_t astnodeAddr, addr_t paramAryAddr, uint32_t paramCount);
 EXPORTC addr_t getErrorSystem(addr_t eAddr);
@@ -66,8 +68,10 @@ EXPORTC addr_t concatWord(addr_t eAddr, addr_t aryAddr, uint32_t count);
 EXPORTC bool isDatumEmpty(addr_t dAddr);
 EXPORTC addr_t createList(addr_t eAddr, addr_t aryAddr, uint32_t count);
 EXPORTC addr_t createSentence(addr_t eAddr, addr_t aryAddr, uint32_t count);
+EXPORTC addr_t sentenceInPlace(addr_t eAddr, addr_t nameAddr, addr_t aryAddr, uint32_t count);
 EXPORTC addr_t fputList(addr_t eAddr, addr_t thingAddr, addr_t listAddr);
 EXPORTC addr_t lputList(addr_t eAddr, addr_t thingAddr, addr_t listAddr);
+EXPORTC addr_t lputListInPlace(addr_t eAddr, addr_t nameAddr, addr_t thingAddr, addr_t listAddr);
 EXPORTC addr_t createArray(addr_t eAddr, int32_t size, int32_t origin);
 EXPORTC addr_t listToArray(addr_t eAddr, addr_t listAddr, int32_t origin);
 EXPORTC addr_t arrayToList(addr_t eAddr, addr_t arrayAddr);
@@ -75,10 +79,22 @@ EXPORTC addr_t firstOfDatum(addr_t eAddr, addr_t thingAddr);
 EXPORTC addr_t lastOfDatum(addr_t eAddr, addr_t thingAddr);
 EXPORTC addr_t butFirstOfDatum(addr_t eAddr, addr_t thingAddr);
 EXPORTC addr_t butLastOfDatum(addr_t eAddr, addr_t thingAddr);
+EXPORTC addr_t butLastInPlace(addr_t eAddr, addr_t nameAddr, addr_t thingAddr);
 EXPORTC bool isDatumIndexValid(addr_t thingAddr, double dIndex, addr_t listItemPtrAddr);
 EXPORTC addr_t itemOfDatum(addr_t eAddr, addr_t thingAddr, double dIndex, addr_t listItemPtrAddr);
+EXPORTC bool isItemPackedNumber(addr_t thingAddr, double dIndex);
+EXPORTC double packedNumberOfItem(addr_t thingAddr, double dIndex);
 EXPORTC bool isDatumContainerOrInContainer(addr_t eAddr, addr_t valueAddr, addr_t containerAddr);
 EXPORTC void setDatumAtIndexOfContainer(addr_t valueAddr, double dIndex, addr_t containerAddr);
+EXPORTC void setDoubleAtIndexOfArray(double val, double dIndex, addr_t arrayAddr);
+EXPORTC bool isMdArraySizeListValid(addr_t sizesAddr);
+EXPORTC addr_t createMdArray(addr_t eAddr, addr_t sizesAddr, int32_t origin);
+EXPORTC bool isMdIndexValid(addr_t indexAddr, addr_t arrayAddr, bool isEmptyValid);
+EXPORTC addr_t arrayOfMdIndex(addr_t indexAddr, addr_t arrayAddr);
+EXPORTC addr_t mdItemOfArray(addr_t eAddr, addr_t indexAddr, addr_t arrayAddr);
+EXPORTC bool isMdItemPackedNumber(addr_t indexAddr, addr_t arrayAddr);
+EXPORTC double packedNumberOfMdItem(addr_t indexAddr, addr_t arrayAddr);
+EXPORTC void setDatumAtMdIndexOfArray(addr_t valueAddr, addr_t indexAddr, addr_t arrayAddr);
 EXPORTC void setFirstOfList(addr_t listAddr, addr_t valueAddr);
 EXPORTC void setButfirstOfList(addr_t listAddr, addr_t valueAddr);
 EXPORTC bool isEmpty(addr_t thingAddr);
@@ -93,13 +109,21 @@ EXPORTC double ascii(addr_t cAddr);
 EXPORTC double rawascii(addr_t cAddr);
 EXPORTC addr_t chr(addr_t eAddr, uint32_t c);
 EXPORTC addr_t member(addr_t eAddr, addr_t thing1Addr, addr_t thing2Addr);
+EXPORTC addr_t removeDuplicates(addr_t eAddr, addr_t thingAddr);
 EXPORTC addr_t lowercase(addr_t eAddr, addr_t wordAddr);
 EXPORTC addr_t uppercase(addr_t eAddr, addr_t wordAddr);
 EXPORTC addr_t standout(addr_t eAddr, addr_t thingAddr);
 EXPORTC addr_t parse(addr_t eAddr, addr_t wordAddr);
 EXPORTC addr_t runparseDatum(addr_t eAddr, addr_t wordorlistAddr);
+EXPORTC addr_t createDictionary(addr_t eAddr);
+EXPORTC void dictionaryPut(addr_t eAddr, addr_t dictAddr, addr_t keyAddr, addr_t valueAddr);
+EXPORTC addr_t dictionaryGet(addr_t eAddr, addr_t dictAddr, addr_t keyAddr);
+EXPORTC void dictionaryRemove(addr_t eAddr, addr_t dictAddr, addr_t keyAddr);
+EXPORTC addr_t dictionaryKeys(addr_t eAddr, addr_t dictAddr);
 EXPORTC void moveTurtleForward(double distance);
+EXPORTC void moveTurtleForwardSteps(addr_t stepAryAddr, int32_t count);
 EXPORTC void moveTurtleRotate(double angle);
+EXPORTC void moveTurtleRotateSteps(addr_t stepAryAddr, int32_t count);
 EXPORTC void setTurtleXY(double x, double y);
 EXPORTC void setTurtleX(double x);
 EXPORTC void setTurtleY(double y);
@@ -149,6 +173,21 @@ EXPORTC double getMouseButton(void);
 EXPORTC bool getvarErroract(void);
 EXPORTC addr_t inputProcedure(addr_t eAddr, addr_t nodeAddr);
 EXPORTC void setVarAsLocal(addr_t varname);
+EXPORTC addr_t propertyListForWord(addr_t nameAddr);
+EXPORTC addr_t findPropertyListForWord(addr_t nameAddr);
+EXPORTC int32_t propertySymbolForWord(addr_t nameAddr);
+EXPORTC int32_t findPropertySymbolForWord(addr_t nameAddr);
+EXPORTC addr_t getPropertyOfList(addr_t eAddr, addr_t plistAddr, int32_t propSymbol);
+EXPORTC void setPropertyOfList(addr_t plistAddr, int32_t propSymbol, addr_t valueAddr);
+EXPORTC void removePropertyOfList(addr_t plistAddr, int32_t propSymbol);
+EXPORTC addr_t getPropertyListOfList(addr_t eAddr, addr_t plistAddr);
+EXPORTC bool isPropertyListNotEmpty(addr_t plistAddr);
+EXPORTC addr_t nodeCounts(addr_t eAddr);
+EXPORTC addr_t heapStats(addr_t eAddr);
+EXPORTC addr_t heapSnapshot(addr_t eAddr);
+EXPORTC void enterAllocationSite(addr_t nodeAddr);
+EXPORTC void leaveAllocationSite(addr_t nodeAddr);
+EXPORTC addr_t allocationReport(addr_t eAddr);
 EXPORTC addr_t handleBadDouble(addr_t eAddr, addr_t parentAddr, double value);
 EXPORTC addr_t handleBadDatum(addr_t eAddr, addr_t parentAddr, addr_t valueAddr);
 #endif // WORKSPACE_EXPORTS_H
\ No newline at end of file
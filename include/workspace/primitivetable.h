@@ -93,6 +93,7 @@ stringToCmd[StringConstants::cmdStrSE()] = {&Compiler::genSentence, 0, 2, -1, Re
 stringToCmd[StringConstants::cmdStrFPUT()] = {&Compiler::genFput, 2, 2, 2, RequestReturnD};
 stringToCmd[StringConstants::cmdStrLPUT()] = {&Compiler::genLput, 2, 2, 2, RequestReturnD};
 stringToCmd[StringConstants::cmdStrARRAY()] = {&Compiler::genArray, 1, 1, 2, RequestReturnD};
+stringToCmd[StringConstants::cmdStrMDARRAY()] = {&Compiler::genMdarray, 1, 1, 2, RequestReturnD};
 stringToCmd[StringConstants::cmdStrLISTTOARRAY()] = {&Compiler::genListtoarray, 1, 1, 2, RequestReturnD};
 stringToCmd[StringConstants::cmdStrARRAYTOLIST()] = {&Compiler::genArraytolist, 1, 1, 1, RequestReturnD};
 stringToCmd[StringConstants::cmdStrFIRST()] = {&Compiler::genFirst, 1, 1, 1, RequestReturnD};
@@ -102,7 +103,9 @@ stringToCmd[StringConstants::cmdStrBF()] = {&Compiler::genButfirst, 1, 1, 1, Req
 stringToCmd[StringConstants::cmdStrBUTLAST()] = {&Compiler::genButlast, 1, 1, 1, RequestReturnD};
 stringToCmd[StringConstants::cmdStrBL()] = {&Compiler::genButlast, 1, 1, 1, RequestReturnD};
 stringToCmd[StringConstants::cmdStrITEM()] = {&Compiler::genItem, 2, 2, 2, RequestReturnD};
+stringToCmd[StringConstants::cmdStrMDITEM()] = {&Compiler::genMditem, 2, 2, 2, RequestReturnD};
 stringToCmd[StringConstants::cmdStrSETITEM()] = {&Compiler::genSetitem, 3, 3, 3, RequestReturnN};
+stringToCmd[StringConstants::cmdStrMDSETITEM()] = {&Compiler::genMdsetitem, 3, 3, 3, RequestReturnN};
 stringToCmd[StringConstants::cmdStr_dot_SETITEM()] = {&Compiler::genDotSetitem, 3, 3, 3, RequestReturnN};
 stringToCmd[StringConstants::cmdStr_dot_SETFIRST()] = {&Compiler::genDotSetfirst, 2, 2, 2, RequestReturnN};
 stringToCmd[StringConstants::cmdStr_dot_SETBF()] = {&Compiler::genDotSetbf, 2, 2, 2, RequestReturnN};
@@ -130,11 +133,19 @@ stringToCmd[StringConstants::cmdStrASCII()] = {&Compiler::genAscii, 1, 1, 1, Req
 stringToCmd[StringConstants::cmdStrRAWASCII()] = {&Compiler::genRawascii, 1, 1, 1, RequestReturnN};
 stringToCmd[StringConstants::cmdStrCHAR()] = {&Compiler::genChar, 1, 1, 1, RequestReturnD};
 stringToCmd[StringConstants::cmdStrMEMBER()] = {&Compiler::genMember, 2, 2, 2, RequestReturnD};
+stringToCmd[StringConstants::cmdStrREMDUP()] = {&Compiler::genRemdup, 1, 1, 1, RequestReturnD};
 stringToCmd[StringConstants::cmdStrLOWERCASE()] = {&Compiler::genLowercase, 1, 1, 1, RequestReturnD};
 stringToCmd[StringConstants::cmdStrUPPERCASE()] = {&Compiler::genUppercase, 1, 1, 1, RequestReturnD};
 stringToCmd[StringConstants::cmdStrSTANDOUT()] = {&Compiler::genStandout, 1, 1, 1, RequestReturnD};
 stringToCmd[StringConstants::cmdStrPARSE()] = {&Compiler::genParse, 1, 1, 1, RequestReturnD};
 stringToCmd[StringConstants::cmdStrRUNPARSE()] = {&Compiler::genRunparse, 1, 1, 1, RequestReturnD};
+stringToCmd[StringConstants::cmdStrDICTIONARY()] = {&Compiler::genDictionary, 0, 0, 0, RequestReturnD};
+stringToCmd[StringConstants::cmdStrDICTPUT()] = {&Compiler::genDictput, 3, 3, 3, RequestReturnN};
+stringToCmd[StringConstants::cmdStrDICTGET()] = {&Compiler::genDictget, 2, 2, 2, RequestReturnD};
+stringToCmd[StringConstants::cmdStrDICTREMOVE()] = {&Compiler::genDictremove, 2, 2, 2, RequestReturnN};
+stringToCmd[StringConstants::cmdStrDICTKEYS()] = {&Compiler::genDictkeys, 1, 1, 1, RequestReturnD};
+stringToCmd[StringConstants::cmdStrDICTIONARYP()] = {&Compiler::genDictionaryp, 1, 1, 1, RequestReturnB};
+stringToCmd[StringConstants::cmdStrDICTIONARY_Q()] = {&Compiler::genDictionaryp, 1, 1, 1, RequestReturnB};
 stringToCmd[StringConstants::cmdStrFORWARD()] = {&Compiler::genForward, 1, 1, 1, RequestReturnN};
 stringToCmd[StringConstants::cmdStrFD()] = {&Compiler::genForward, 1, 1, 1, RequestReturnN};
 stringToCmd[StringConstants::cmdStrBACK()] = {&Compiler::genBack, 1, 1, 1, RequestReturnN};
@@ -220,3 +231,13 @@ stringToCmd[StringConstants::cmdStrTO()] = {&Compiler::genInputProcedure, -1, -1
 stringToCmd[StringConstants::cmdStr_dot_MACRO()] = {&Compiler::genInputProcedure, -1, -1, -1, RequestReturnN};
 stringToCmd[StringConstants::cmdStrMAKE()] = {&Compiler::genMake, 2, 2, 2, RequestReturnN};
 stringToCmd[StringConstants::cmdStrLOCAL()] = {&Compiler::genLocal, 1, 1, -1, RequestReturnN};
+stringToCmd[StringConstants::cmdStrPPROP()] = {&Compiler::genPprop, 3, 3, 3, RequestReturnN};
+stringToCmd[StringConstants::cmdStrGPROP()] = {&Compiler::genGprop, 2, 2, 2, RequestReturnD};
+stringToCmd[StringConstants::cmdStrREMPROP()] = {&Compiler::genRemprop, 2, 2, 2, RequestReturnN};
+stringToCmd[StringConstants::cmdStrPLIST()] = {&Compiler::genPlist, 1, 1, 1, RequestReturnD};
+stringToCmd[StringConstants::cmdStrPLISTP()] = {&Compiler::genPlistp, 1, 1, 1, RequestReturnB};
+stringToCmd[StringConstants::cmdStrPLIST_Q()] = {&Compiler::genPlistp, 1, 1, 1, RequestReturnB};
+stringToCmd[StringConstants::cmdStrNODES()] = {&Compiler::genNodes, 0, 0, 0, RequestReturnD};
+stringToCmd[StringConstants::cmdStrHEAPSTATS()] = {&Compiler::genHeapstats, 0, 0, 0, RequestReturnD};
+stringToCmd[StringConstants::cmdStrHEAPSNAPSHOT()] = {&Compiler::genHeapsnapshot, 0, 0, 0, RequestReturnD};
+stringToCmd[StringConstants::cmdStrALLOCATIONS()] = {&Compiler::genAllocations, 0, 0, 0, RequestReturnD};
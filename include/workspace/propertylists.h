@@ -19,54 +19,120 @@
 
 #include "datum_ptr.h"
 #include <QHash>
+#include <QList>
 #include <QString>
+#include <utility>
 
 /// @brief A class to manage property lists.
-/// This is a hash table of property lists, with each property list being a hash table of property names to
-/// property values.
+///
+/// Property list names and property names are interned. Each property list is an
+/// object that is created when a property is first added to it, and is dropped when it
+/// has no properties left unless compiled code refers to it directly. Each property name
+/// is given a small integer symbol, so looking up a property only compares integers.
+/// Looking up a name that was never given a property doesn't intern it.
 class PropertyLists
 {
-    /// @brief The hash table of property lists.
-    QHash<QString, QHash<QString, DatumPtr>> plists;
+  public:
+    /// @brief One property list.
+    struct PropertyList
+    {
+        /// @brief The name of the property list, as it was first given.
+        DatumPtr name;
+
+        /// @brief The properties as pairs of property symbols and values, in the order they
+        /// were added. Property lists are usually short, so a linear search is fastest.
+        QList<std::pair<int, DatumPtr>> properties;
+
+        /// @brief Set once compiled code holds a pointer to the property list, which then
+        /// lives as long as the PropertyLists.
+        bool isPinned = false;
+
+        /// @brief Get a property.
+        /// @param propSymbol The symbol of the property name.
+        /// @return The value of the property or an empty list if the property does not exist.
+        const DatumPtr &getProperty(int propSymbol) const;
+
+        /// @brief Add a property, or replace its value if it already exists.
+        /// @param propSymbol The symbol of the property name.
+        /// @param value The value of the property.
+        void addProperty(int propSymbol, const DatumPtr &value);
+
+        /// @brief Remove a property.
+        /// @param propSymbol The symbol of the property name.
+        void removeProperty(int propSymbol);
+
+        /// @brief Return true if the property list has any properties.
+        bool isPropertyList() const
+        {
+            return !properties.isEmpty();
+        }
+    };
+
+  private:
+    /// @brief The property lists, keyed by name.
+    QHash<QString, PropertyList *> plists;
+
+    /// @brief The symbols of the property names, keyed by name.
+    QHash<QString, int> symbols;
+
+    /// @brief The property names, indexed by symbol, as they were first given.
+    QList<DatumPtr> symbolNames;
 
   public:
     /// @brief Constructor.
     PropertyLists();
 
-    /// @brief Add a property to a property list.
+    /// @brief Destructor.
+    ~PropertyLists();
+
+    PropertyLists(const PropertyLists &) = delete;
+    PropertyLists &operator=(const PropertyLists &) = delete;
+
+    /// @brief Get the property list with the given name, creating it if needed.
     /// @param plistname The name of the property list.
-    /// @param propname The name of the property.
-    /// @param value The value of the property.
-    void addProperty(const QString &plistname, const QString &propname, const DatumPtr &value);
+    /// @return The property list. Unless it is pinned, it is valid only until a property
+    /// is removed from it.
+    PropertyList *propertyListForName(const DatumPtr &plistname);
 
-    /// @brief Get a property from a property list.
+    /// @brief Find the property list with the given name.
     /// @param plistname The name of the property list.
+    /// @return The property list, or nullptr if there is none.
+    PropertyList *findPropertyList(const DatumPtr &plistname) const;
+
+    /// @brief Get the symbol for a property name, creating it if needed.
     /// @param propname The name of the property.
-    /// @return The value of the property or an empty list if the property does not exist.
-    DatumPtr getProperty(const QString &plistname, const QString &propname) const;
+    /// @return The symbol of the property name.
+    int symbolForPropertyName(const DatumPtr &propname);
 
-    /// @brief Remove a property from a property list.
-    /// @param plistname The name of the property list.
+    /// @brief Find the symbol for a property name.
     /// @param propname The name of the property.
-    void removeProperty(const QString &plistname, const QString &propname);
+    /// @return The symbol of the property name, or -1 if no property was ever given that name.
+    int findSymbol(const DatumPtr &propname) const;
+
+    /// @brief Remove a property, and the property list too if that was its last property.
+    /// @param plist The property list.
+    /// @param propSymbol The symbol of the property name.
+    void removeProperty(PropertyList *plist, int propSymbol);
 
     /// @brief Get a property list.
-    /// @param plistname The name of the property list.
+    /// @param plist The property list.
     /// @return The property list as a list of alternating property names and values.
-    DatumPtr getPropertyList(const QString &plistname) const;
+    DatumPtr getPropertyList(const PropertyList *plist) const;
 
-    /// @brief Remove a property list.
+    /// @brief Remove all properties from a property list, and the property list too.
     /// @param plistname The name of the property list.
-    void erasePropertyList(const QString &plistname);
-
-    /// @brief Check if a property list exists.
-    /// @param plistname The name of the property list.
-    /// @return True if the property list exists, false otherwise.
-    bool isPropertyList(const QString &plistname) const;
+    void erasePropertyList(const DatumPtr &plistname);
 
     /// @brief Get all property lists.
-    /// @return A list of all property lists.
+    /// @return A list of the names of all property lists that have properties.
     DatumPtr allPLists() const;
+
+    /// @brief Get all property lists, including pinned ones without properties.
+    /// @return The property lists, keyed by name.
+    const QHash<QString, PropertyList *> &propertyLists() const
+    {
+        return plists;
+    }
 };
 
 #endif // PROPERTYLISTS_H
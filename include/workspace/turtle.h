@@ -127,6 +127,13 @@ class Turtle
     /// @param angle The angle to rotate the turtle by.
     void rotate(double angle);
 
+    /// @brief Rotate the turtle by each of a sequence of angles in turn.
+    /// @param angles The angles to rotate the turtle by.
+    /// @param count The number of angles.
+    /// @note The result is the same as calling rotate() for each angle, but the turtle
+    /// is redrawn only once.
+    void rotate(const double *angles, qsizetype count);
+
     /// @brief Move the turtle forward by a given number of steps.
     /// @param steps The number of steps to move the turtle forward.
     void forward(double steps);
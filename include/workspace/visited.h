@@ -17,18 +17,150 @@
 ///
 //===----------------------------------------------------------------------===//
 
-#include <QMap>
-#include <QSet>
+#include <QtGlobal>
 
 class Datum;
 
+/// @brief An open-addressing hash table keyed by Datum pointers.
+/// @details The first few entries are stored inside the table itself, so searching a small
+/// structure never allocates. Entries are found by linear probing, and removing an entry
+/// shifts the entries after it back rather than leaving a tombstone.
+template <typename T>
+class VisitedTable
+{
+    struct Slot
+    {
+        const Datum *key;
+        T value;
+    };
+
+    static constexpr qsizetype inlineCapacity = 16;
+
+    Slot inlineSlots[inlineCapacity];
+    Slot *slots = inlineSlots;
+    qsizetype capacity = inlineCapacity; // Always a power of two.
+    qsizetype count = 0;
+
+    qsizetype homeOf(const Datum *key) const
+    {
+        // Datums are at least 16-byte aligned, so the low bits of the address carry nothing.
+        quint64 h = (static_cast<quint64>(reinterpret_cast<quintptr>(key)) >> 4) * 0x9E3779B97F4A7C15ULL;
+        h ^= h >> 32;
+        return static_cast<qsizetype>(h) & (capacity - 1);
+    }
+
+    qsizetype slotOf(const Datum *key) const
+    {
+        qsizetype i = homeOf(key);
+        while ((slots[i].key != nullptr) && (slots[i].key != key))
+            i = (i + 1) & (capacity - 1);
+        return i;
+    }
+
+    void grow()
+    {
+        Slot *oldSlots = slots;
+        qsizetype oldCapacity = capacity;
+        capacity *= 2;
+        slots = new Slot[capacity];
+        for (qsizetype i = 0; i < capacity; ++i)
+            slots[i].key = nullptr;
+        for (qsizetype i = 0; i < oldCapacity; ++i)
+        {
+            if (oldSlots[i].key != nullptr)
+                slots[slotOf(oldSlots[i].key)] = oldSlots[i];
+        }
+        if (oldSlots != inlineSlots)
+            delete[] oldSlots;
+    }
+
+  public:
+    VisitedTable()
+    {
+        for (auto &slot : inlineSlots)
+            slot.key = nullptr;
+    }
+
+    ~VisitedTable()
+    {
+        if (slots != inlineSlots)
+            delete[] slots;
+    }
+
+    VisitedTable(const VisitedTable &) = delete;
+    VisitedTable &operator=(const VisitedTable &) = delete;
+
+    /// @brief Return a pointer to the value stored for key, or nullptr if there is none.
+    const T *find(const Datum *key) const
+    {
+        const Slot &slot = slots[slotOf(key)];
+        return (slot.key != nullptr) ? &slot.value : nullptr;
+    }
+
+    /// @brief Store a value for key, replacing any value already stored.
+    void insert(const Datum *key, const T &value)
+    {
+        // Keep the table at most half full so that probe sequences stay short.
+        if ((count + 1) * 2 > capacity)
+            grow();
+        Slot &slot = slots[slotOf(key)];
+        if (slot.key == nullptr)
+        {
+            slot.key = key;
+            ++count;
+        }
+        slot.value = value;
+    }
+
+    /// @brief Remove key and its value, if present.
+    void remove(const Datum *key)
+    {
+        qsizetype mask = capacity - 1;
+        qsizetype hole = slotOf(key);
+        if (slots[hole].key == nullptr)
+            return;
+        --count;
+
+        // Move back any entry that would no longer be found once the hole is empty.
+        qsizetype i = hole;
+        while (true)
+        {
+            i = (i + 1) & mask;
+            if (slots[i].key == nullptr)
+                break;
+            qsizetype home = homeOf(slots[i].key);
+            bool isHomeAfterHole = (i > hole) ? ((home > hole) && (home <= i)) : ((home > hole) || (home <= i));
+            if (!isHomeAfterHole)
+            {
+                slots[hole] = slots[i];
+                hole = i;
+            }
+        }
+        slots[hole].key = nullptr;
+    }
+
+    /// @brief Remove all entries.
+    void clear()
+    {
+        if (slots != inlineSlots)
+        {
+            delete[] slots;
+            slots = inlineSlots;
+            capacity = inlineCapacity;
+        }
+        for (auto &slot : inlineSlots)
+            slot.key = nullptr;
+        count = 0;
+    }
+};
+
 /// @brief A set of visited nodes.
 /// @details The VisitedSet class is used to track visited nodes during Datum graph traversal,
 /// in order to prevent cycles when comparing Datum objects. The node is the Datum object that has been visited.
 class VisitedSet
 {
   protected:
-    QSet<const Datum *> visited;
+    VisitedTable<bool> visited;
 
   public:
     /// @brief Create an empty VisitedSet.
@@ -58,7 +190,7 @@ class VisitedSet
 class VisitedMap
 {
   protected:
-    QMap<const Datum *, const Datum *> visited;
+    VisitedTable<const Datum *> visited;
 
   public:
     /// @brief Create an empty VisitedMap.
@@ -17,6 +17,7 @@
 #include "compiler.h"
 #include "astnode.h"
 #include "compiler_internal.h"
+#include "compiler_ir.h"
 #include "llvm/ExecutionEngine/Orc/LLJIT.h"
 #include "llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h"
 #include "llvm/Support/Error.h"
@@ -29,6 +30,7 @@
 #include "treeifyer.h"
 #include "workspace/callframe.h"
 #include "workspace/procedures.h"
+#include <QScopeGuard>
 #include <string>
 
 QHash<Datum *, std::shared_ptr<CompiledText>> Compiler::compiledTextTable;
@@ -198,6 +200,24 @@ CompiledFunctionPtr Compiler::generateFunctionPtrFromASTList(QList<QList<DatumPt
     Scaffold compilerScaffolding(lljit->getDataLayout());
     scaff = &compilerScaffolding;
 
+    // Run the Logo-level passes and generate from what remains.
+    LogoIR logoIR(parsedList);
+    logoIR.optimize();
+    if (Config::get().showLIR)
+    {
+        fprintf(stderr, "%s\n", qPrintable(logoIR.toString()));
+    }
+    parsedList = logoIR.lowered();
+    lir = &logoIR;
+    readValues.clear();
+
+    // The IR and the values read from it belong to this call, so forget them on the way
+    // out, whether or not generation succeeds.
+    auto lirGuard = qScopeGuard([this] {
+        lir = nullptr;
+        readValues.clear();
+    });
+
     auto *compiledText = new CompiledText();
     compiledText->astList = parsedList;
     compiledText->compiler = this;
@@ -361,11 +381,40 @@ void Compiler::destroyCompiledTextForDatum(Datum *aDatum)
 
 Value *Compiler::generateChildOfNode(ASTNode *parent, const DatumPtr &node, RequestReturnType returnType)
 {
+    // A read that the Logo-level IR found to be redundant reuses the value of the earlier read,
+    // unless the earlier read was never generated (e.g. an input that its node ignores).
+    const ASTNode *source = lir->sourceOfRead(node.astnodeValue());
+    if ((source != nullptr) && readValues.contains(source))
+    {
+        return generatePinnedRead(node, readValues[source]);
+    }
+
     Generator method = node.astnodeValue()->genExpression;
-    Value *retval = ((this->*method)(node, returnType));
+    ASTNode *outerParent = generatingParent;
+    generatingParent = parent;
+    Value *retval;
+    if (Config::get().profileAllocations)
+    {
+        Value *site = CoAddr(node.astnodeValue());
+        generateCallExtern(TyVoid, enterAllocationSite, PaAddr(site));
+        retval = ((this->*method)(node, returnType));
+        generateCallExtern(TyVoid, leaveAllocationSite, PaAddr(site));
+    }
+    else
+    {
+        retval = ((this->*method)(node, returnType));
+    }
+    generatingParent = outerParent;
     return retval;
 }
 
+Value *Compiler::generatePinnedRead(const DatumPtr &node, Value *value)
+{
+    if (!lir->isPinnedRead(node.astnodeValue()))
+        return value;
+    return generateCallExtern(TyAddr, pinDatum, PaAddr(evaluator), PaAddr(value));
+}
+
 Value *Compiler::generateCast(Value *src, ASTNode *parent, const DatumPtr &node, RequestReturnType destReturnType)
 {
     Q_ASSERT(!src->getType()->isVoidTy());
@@ -452,7 +501,7 @@ Value *Compiler::generateChild(ASTNode *parent, const DatumPtr &node, RequestRet
 
 Value *Compiler::generateChild(ASTNode *parent, unsigned int index, RequestReturnType returnType)
 {
-    DatumPtr node = parent->childAtIndex(index);
+    const DatumPtr &node = parent->childAtIndex(index);
     return generateChild(parent, node, returnType);
 }
 
@@ -468,6 +517,36 @@ Value *Compiler::generateDoubleFromDatum(ASTNode *parent, Value *src)
     return retval;
 }
 
+Value *Compiler::generateDoubleFromMember(ASTNode *parent,
+                                          Value *isPacked,
+                                          const std::function<Value *()> &generatePacked,
+                                          const std::function<Value *()> &generateDatum)
+{
+    Function *theFunction = scaff->builder.GetInsertBlock()->getParent();
+    BasicBlock *packedBB = BasicBlock::Create(*scaff->theContext, DBG_NAME("isPacked"), theFunction);
+    BasicBlock *datumBB = BasicBlock::Create(*scaff->theContext, DBG_NAME("isDatum"), theFunction);
+    BasicBlock *mergeBB = BasicBlock::Create(*scaff->theContext, DBG_NAME("memberMerge"), theFunction);
+
+    Value *cond = scaff->builder.CreateICmpEQ(isPacked, CoBool(true), DBG_NAME("isPackedTest"));
+    scaff->builder.CreateCondBr(cond, packedBB, datumBB);
+
+    scaff->builder.SetInsertPoint(packedBB);
+    Value *packedValue = generatePacked();
+    scaff->builder.CreateBr(mergeBB);
+
+    scaff->builder.SetInsertPoint(datumBB);
+    Value *datumValue = generateDoubleFromDatum(parent, generateDatum());
+    // The validation leaves the builder in a later block.
+    datumBB = scaff->builder.GetInsertBlock();
+    scaff->builder.CreateBr(mergeBB);
+
+    scaff->builder.SetInsertPoint(mergeBB);
+    PHINode *phi = scaff->builder.CreatePHI(TyDouble, 2, DBG_NAME("memberValue"));
+    phi->addIncoming(packedValue, packedBB);
+    phi->addIncoming(datumValue, datumBB);
+    return phi;
+}
+
 Value *Compiler::generateBoolFromDatum(ASTNode *parent, Value *src)
 {
     Value *retval = nullptr;
@@ -555,9 +634,16 @@ Value *Compiler::generateArrayFromDatum(ASTNode *parent, Value *src)
     return generateFromDatum(Datum::typeArray, parent, src);
 }
 
+Value *Compiler::generateDictionaryFromDatum(ASTNode *parent, Value *src)
+{
+    return generateFromDatum(Datum::typeDictionary, parent, src);
+}
+
 Value *Compiler::genLiteral(const DatumPtr &node, RequestReturnType returnType)
 {
-    DatumPtr literalPtr = node.astnodeValue()->childAtIndex(0);
+    // Take a reference so that a number held as an immediate is boxed in the AST,
+    // which outlives the compiled code that refers to it.
+    const DatumPtr &literalPtr = node.astnodeValue()->childAtIndex(0);
 
     // A literal is a Word, List, or Array.
     // However, the caller may want a Bool or Real.
@@ -598,7 +684,7 @@ Value *Compiler::genValueOf(const DatumPtr &node, RequestReturnType returnType)
 
     Word *varName = node.astnodeValue()->childAtIndex(0).wordValue();
     Value *nameAddr = CoAddr(varName);
-    Value *retval = generateCallExtern(TyAddr, getDatumForVarname, PaAddr(nameAddr));
+    Value *retval = generateCallExtern(TyAddr, getDatumForVarname, PaAddr(evaluator), PaAddr(nameAddr));
 
     Value *dType = generateGetDatumIsa(retval);
     Value *mask = scaff->builder.CreateAnd(dType, CoInt32(Datum::typeDataMask), DBG_NAME("dataMask"));
@@ -610,7 +696,8 @@ Value *Compiler::genValueOf(const DatumPtr &node, RequestReturnType returnType)
     scaff->builder.CreateRet(errObj);
 
     scaff->builder.SetInsertPoint(hasValueBB);
-    return retval;
+    readValues[node.astnodeValue()] = retval;
+    return generatePinnedRead(node, retval);
 }
 
 Value *Compiler::genExecProcedure(const DatumPtr &node, RequestReturnType returnType)
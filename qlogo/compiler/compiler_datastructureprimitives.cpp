@@ -26,13 +26,28 @@
 
 using namespace llvm;
 using namespace llvm::orc;
-/// @brief Determine if the given Datums are equal, according to `EQUALP` help text.
-/// @param visited The set of visited nodes.
-/// @param d1 The first Datum to compare.
-/// @param d2 The second Datum to compare.
+/// @brief Determine if the given Words are equal, according to `EQUALP` help text.
+/// @param w1 The first Word to compare.
+/// @param w2 The second Word to compare.
 /// @param cs The case sensitivity to use for the comparison.
-/// @returns true if the Datums are equal, false otherwise.
-bool areDatumsEqual(VisitedMap &visited, Datum *d1, Datum *d2, Qt::CaseSensitivity cs)
+/// @returns true if the Words are equal, false otherwise.
+bool areWordsEqual(Word *w1, Word *w2, Qt::CaseSensitivity cs)
+{
+    if (w1->isSourceNumber() || w2->isSourceNumber())
+        return w1->numberValue() == w2->numberValue();
+
+    // Compare views, so that a string stored inside a word isn't copied to compare it.
+    return w1->withPrintableView([w2, cs](auto view1) {
+        return w2->withPrintableView([view1, cs](auto view2) { return view1.compare(view2, cs) == 0; });
+    });
+}
+
+/// @brief The number of list cells a comparison walks before it starts recording them.
+/// Only circular lists can be compared for longer than this, so most comparisons never
+/// touch the VisitedMap.
+static constexpr int untrackedCellLimit = 256;
+
+static bool areDatumsEqual(VisitedMap &visited, int &untrackedCells, Datum *d1, Datum *d2, Qt::CaseSensitivity cs)
 {
     if (d1 == d2)
         return true;
@@ -41,12 +56,7 @@ bool areDatumsEqual(VisitedMap &visited, Datum *d1, Datum *d2, Qt::CaseSensitivi
 
     if (d1->isWord())
     {
-        Word *w1 = d1->wordValue();
-        Word *w2 = d2->wordValue();
-        if (w1->isSourceNumber() || w2->isSourceNumber())
-            return w1->numberValue() == w2->numberValue();
-
-        return w1->toString().compare(w2->toString(), cs) == 0;
+        return areWordsEqual(d1->wordValue(), d2->wordValue(), cs);
     }
     else if (d1->isList())
     {
@@ -62,19 +72,30 @@ bool areDatumsEqual(VisitedMap &visited, Datum *d1, Datum *d2, Qt::CaseSensitivi
 
         while (l1 != EmptyList::instance() && l2 != EmptyList::instance())
         {
-            if (!areDatumsEqual(visited, l1->head.datumValue(), l2->head.datumValue(), cs))
+            if (l1->head.isImmediateNumber() && l2->head.isImmediateNumber())
+            {
+                // Compare numbers without boxing them into the lists.
+                if (l1->head.immediateNumber() != l2->head.immediateNumber())
+                    return false;
+            }
+            else if (!areDatumsEqual(visited, untrackedCells, l1->head.datumValue(), l2->head.datumValue(), cs))
+            {
                 return false;
-            visited.add(l1, l2);
+            }
+            if (untrackedCells > 0)
+                --untrackedCells;
+            else
+                visited.add(l1, l2);
             l1 = l1->tail.listValue();
             l2 = l2->tail.listValue();
         }
 
         return l1 && l2 && l1->isEmpty() && l2->isEmpty();
     }
-    else if (d1->isArray())
+    else if (d1->isArray() || d1->isDictionary())
     {
-        // Arrays are equal iff they are the same array, which would have
-        // passed the "datum1 == datum2" test at the beginning.
+        // Arrays and dictionaries are equal iff they are the same object, which
+        // would have passed the "datum1 == datum2" test at the beginning.
         return false;
     }
     else
@@ -83,6 +104,19 @@ bool areDatumsEqual(VisitedMap &visited, Datum *d1, Datum *d2, Qt::CaseSensitivi
     }
     return false;
 }
+
+/// @brief Determine if the given Datums are equal, according to `EQUALP` help text.
+/// @param visited The set of visited nodes.
+/// @param d1 The first Datum to compare.
+/// @param d2 The second Datum to compare.
+/// @param cs The case sensitivity to use for the comparison.
+/// @returns true if the Datums are equal, false otherwise.
+bool areDatumsEqual(VisitedMap &visited, Datum *d1, Datum *d2, Qt::CaseSensitivity cs)
+{
+    int untrackedCells = untrackedCellLimit;
+    return areDatumsEqual(visited, untrackedCells, d1, d2, cs);
+}
+
 Value *Compiler::generateNotEmptyWordOrListFromDatum(ASTNode *parent, Value *src)
 {
     auto validator = [this](Value *wordorlist) {
@@ -281,7 +315,15 @@ COD***/
 Value *Compiler::genSentence(const DatumPtr &node, RequestReturnType returnType)
 {
     Q_ASSERT(returnType && RequestReturnDatum);
+    bool isInPlace = (node.astnodeValue() == inPlaceListNode);
     AllocaInst *ary = generateChildrenAlloca(node.astnodeValue(), RequestReturnDatum, "sentenceAry");
+    if (isInPlace)
+        return generateCallExtern(TyAddr,
+                                  sentenceInPlace,
+                                  PaAddr(evaluator),
+                                  PaAddr(CoAddr(inPlaceVarName)),
+                                  PaAddr(ary),
+                                  PaInt32(ary->getArraySize()));
     return generateCallExtern(TyAddr, createSentence, PaAddr(evaluator), PaAddr(ary), PaInt32(ary->getArraySize()));
 }
 /***DOC FPUT
@@ -316,6 +358,7 @@ Value *Compiler::genLput(const DatumPtr &node, RequestReturnType returnType)
 Value *Compiler::generateFputlput(const DatumPtr &node, RequestReturnType returnType, bool isLput)
 {
     Q_ASSERT(returnType && RequestReturnDatum);
+    bool isInPlace = (node.astnodeValue() == inPlaceListNode);
     Value *thing = generateChild(node.astnodeValue(), 0, RequestReturnDatum);
     Value *list = generateChild(node.astnodeValue(), 1, RequestReturnDatum);
     Value *listWordTest = nullptr;
@@ -366,8 +409,14 @@ Value *Compiler::generateFputlput(const DatumPtr &node, RequestReturnType return
     scaff->builder.CreateBr(mergeBB);
 
     scaff->builder.SetInsertPoint(listBB);
-    Value *listRetval = isLput ? generateCallExtern(TyAddr, lputList, PaAddr(evaluator), PaAddr(thing), PaAddr(list))
-                               : generateCallExtern(TyAddr, fputList, PaAddr(evaluator), PaAddr(thing), PaAddr(list));
+    Value *listRetval;
+    if (isLput && isInPlace)
+        listRetval = generateCallExtern(
+            TyAddr, lputListInPlace, PaAddr(evaluator), PaAddr(CoAddr(inPlaceVarName)), PaAddr(thing), PaAddr(list));
+    else if (isLput)
+        listRetval = generateCallExtern(TyAddr, lputList, PaAddr(evaluator), PaAddr(thing), PaAddr(list));
+    else
+        listRetval = generateCallExtern(TyAddr, fputList, PaAddr(evaluator), PaAddr(thing), PaAddr(list));
     scaff->builder.CreateBr(mergeBB);
 
     scaff->builder.SetInsertPoint(mergeBB);
@@ -411,6 +460,41 @@ Value *Compiler::genArray(const DatumPtr &node, RequestReturnType returnType)
 
     return generateCallExtern(TyAddr, createArray, PaAddr(evaluator), PaInt32(size), PaInt32(origin));
 }
+/***DOC MDARRAY
+MDARRAY sizelist
+(MDARRAY sizelist origin)
+
+    outputs a multi-dimensional array.  The first input must be a list
+    of one or more positive integers.  The second input, if present,
+    must be a single integer that applies to every dimension of the array.
+    Ex: (MDARRAY [3 5] 0) outputs a two-dimensional array whose members
+    range from [0 0] to [2 4].
+
+COD***/
+// CMD MDARRAY 1 1 2 d
+Value *Compiler::genMdarray(const DatumPtr &node, RequestReturnType returnType)
+{
+    Q_ASSERT(returnType && RequestReturnDatum);
+    Value *sizes = generateChild(node.astnodeValue(), 0, RequestReturnDatum);
+    Value *origin = nullptr;
+    if (node.astnodeValue()->countOfChildren() == 2)
+    {
+        origin = generateChild(node.astnodeValue(), 1, RequestReturnReal);
+        origin = generateInt32FromDouble(node.astnodeValue(), origin, true);
+    }
+    else
+    {
+        origin = CoInt32(1);
+    }
+
+    auto validator = [this](Value *sizes) {
+        Value *isValid = generateCallExtern(TyBool, isMdArraySizeListValid, PaAddr(sizes));
+        return scaff->builder.CreateICmpEQ(isValid, CoBool(true), "isMdArraySizeListValidCond");
+    };
+    sizes = generateValidationDatum(node.astnodeValue(), sizes, validator);
+
+    return generateCallExtern(TyAddr, createMdArray, PaAddr(evaluator), PaAddr(sizes), PaInt32(origin));
+}
 /***DOC LISTTOARRAY
 LISTTOARRAY list
 (LISTTOARRAY list origin)
@@ -530,8 +614,12 @@ Value *Compiler::genButlast(const DatumPtr &node, RequestReturnType returnType)
     Q_ASSERT(returnType && RequestReturnDatum);
     Value *wordorlist = generateChild(node.astnodeValue(), 0, RequestReturnDatum);
 
+    bool isInPlace = (node.astnodeValue() == inPlaceListNode);
     wordorlist = generateNotEmptyWordOrListFromDatum(node.astnodeValue(), wordorlist);
 
+    if (isInPlace)
+        return generateCallExtern(
+            TyAddr, butLastInPlace, PaAddr(evaluator), PaAddr(CoAddr(inPlaceVarName)), PaAddr(wordorlist));
     return generateCallExtern(TyAddr, butLastOfDatum, PaAddr(evaluator), PaAddr(wordorlist));
 }
 /***DOC ITEM
@@ -549,6 +637,7 @@ COD***/
 Value *Compiler::genItem(const DatumPtr &node, RequestReturnType returnType)
 {
     Q_ASSERT(returnType && RequestReturnDatum);
+    ASTNode *parent = generatingParent;
     Value *index = generateChild(node.astnodeValue(), 0, RequestReturnReal);
     Value *thing = generateChild(node.astnodeValue(), 1, RequestReturnDatum);
 
@@ -563,9 +652,68 @@ Value *Compiler::genItem(const DatumPtr &node, RequestReturnType returnType)
     };
     index = generateValidationDouble(node.astnodeValue(), index, validator);
 
+    // A number packed in an array is read as it is, rather than boxed into a new Word.
+    if ((returnType == RequestReturnReal) && (parent != nullptr))
+    {
+        Value *isPacked = generateCallExtern(TyBool, isItemPackedNumber, PaAddr(thing), PaDouble(index));
+        return generateDoubleFromMember(
+            parent,
+            isPacked,
+            [this, thing, index]() {
+                return generateCallExtern(TyDouble, packedNumberOfItem, PaAddr(thing), PaDouble(index));
+            },
+            [this, thing, index, listItemPtr]() {
+                return generateCallExtern(TyAddr,
+                                          itemOfDatum,
+                                          PaAddr(evaluator),
+                                          PaAddr(thing),
+                                          PaDouble(index),
+                                          PaAddr(CoAddr(listItemPtr)));
+            });
+    }
+
     return generateCallExtern(
         TyAddr, itemOfDatum, PaAddr(evaluator), PaAddr(thing), PaDouble(index), PaAddr(CoAddr(listItemPtr)));
 }
+/***DOC MDITEM
+MDITEM indexlist array
+
+    outputs the member of the multidimensional "array" selected by
+    the list of numbers "indexlist".
+
+COD***/
+// CMD MDITEM 2 2 2 d
+Value *Compiler::genMditem(const DatumPtr &node, RequestReturnType returnType)
+{
+    Q_ASSERT(returnType && RequestReturnDatum);
+    ASTNode *parent = generatingParent;
+    Value *index = generateChild(node.astnodeValue(), 0, RequestReturnDatum);
+    Value *array = generateChild(node.astnodeValue(), 1, RequestReturnDatum);
+    array = generateArrayFromDatum(node.astnodeValue(), array);
+
+    auto validator = [this, array](Value *index) {
+        Value *isValid =
+            generateCallExtern(TyBool, isMdIndexValid, PaAddr(index), PaAddr(array), PaBool(CoBool(true)));
+        return scaff->builder.CreateICmpEQ(isValid, CoBool(true), "isMdIndexValidCond");
+    };
+    index = generateValidationDatum(node.astnodeValue(), index, validator);
+
+    if ((returnType == RequestReturnReal) && (parent != nullptr))
+    {
+        Value *isPacked = generateCallExtern(TyBool, isMdItemPackedNumber, PaAddr(index), PaAddr(array));
+        return generateDoubleFromMember(
+            parent,
+            isPacked,
+            [this, index, array]() {
+                return generateCallExtern(TyDouble, packedNumberOfMdItem, PaAddr(index), PaAddr(array));
+            },
+            [this, index, array]() {
+                return generateCallExtern(TyAddr, mdItemOfArray, PaAddr(evaluator), PaAddr(index), PaAddr(array));
+            });
+    }
+
+    return generateCallExtern(TyAddr, mdItemOfArray, PaAddr(evaluator), PaAddr(index), PaAddr(array));
+}
 /***DOC SETITEM
 SETITEM index array value
 
@@ -580,6 +728,45 @@ Value *Compiler::genSetitem(const DatumPtr &node, RequestReturnType returnType)
     return generateSetitem(node, returnType, false);
 }
 
+/***DOC MDSETITEM
+MDSETITEM indexlist array value
+
+    command.  Replaces the member of "array" chosen by "indexlist"
+    with the new "value".
+
+COD***/
+// CMD MDSETITEM 3 3 3 n
+Value *Compiler::genMdsetitem(const DatumPtr &node, RequestReturnType returnType)
+{
+    Q_ASSERT(returnType && RequestReturnDatum);
+    Value *index = generateChild(node.astnodeValue(), 0, RequestReturnDatum);
+    Value *array = generateChild(node.astnodeValue(), 1, RequestReturnDatum);
+    array = generateArrayFromDatum(node.astnodeValue(), array);
+
+    // The value is evaluated before the index list is followed, since evaluating it may
+    // replace a row of the array, or change the index list.
+    Value *value = generateChild(node.astnodeValue(), 2, RequestReturnDatum);
+
+    auto indexValidator = [this, array](Value *index) {
+        Value *isValid =
+            generateCallExtern(TyBool, isMdIndexValid, PaAddr(index), PaAddr(array), PaBool(CoBool(false)));
+        return scaff->builder.CreateICmpEQ(isValid, CoBool(true), "isMdIndexValidCond");
+    };
+    index = generateValidationDatum(node.astnodeValue(), index, indexValidator);
+
+    // As with SETITEM, the value may not be or contain the array that it's stored in.
+    Value *container = generateCallExtern(TyAddr, arrayOfMdIndex, PaAddr(index), PaAddr(array));
+    auto valueValidator = [this, container](Value *value) {
+        Value *isValid = generateCallExtern(
+            TyBool, isDatumContainerOrInContainer, PaAddr(evaluator), PaAddr(container), PaAddr(value));
+        return scaff->builder.CreateICmpEQ(isValid, CoBool(false), "isDatumInContainerCond");
+    };
+    value = generateValidationDatum(node.astnodeValue(), value, valueValidator);
+
+    generateCallExtern(TyVoid, setDatumAtMdIndexOfArray, PaAddr(value), PaAddr(index), PaAddr(array));
+    return generateVoidRetval(node.astnodeValue());
+}
+
 /***DOC .SETITEM
 .SETITEM index array value
 
@@ -612,6 +799,16 @@ Value *Compiler::generateSetitem(const DatumPtr &node, RequestReturnType returnT
     };
     index = generateValidationDouble(node.astnodeValue(), index, indexValidator);
 
+    // If the value is computed as a number (e.g. by arithmetic), store it without creating a
+    // Word. A number can't contain the array, so there's no circularity to check.
+    const DatumPtr &valueNode = node.astnodeValue()->childAtIndex(2);
+    if (valueNode.isASTNode() && (valueNode.astnodeValue()->returnType == RequestReturnReal))
+    {
+        Value *value = generateChild(node.astnodeValue(), 2, RequestReturnReal);
+        generateCallExtern(TyVoid, setDoubleAtIndexOfArray, PaDouble(value), PaDouble(index), PaAddr(array));
+        return generateVoidRetval(node.astnodeValue());
+    }
+
     Value *value = generateChild(node.astnodeValue(), 2, RequestReturnDatum);
 
     if (!isDangerous)
@@ -733,8 +930,8 @@ Value *Compiler::genListp(const DatumPtr &node, RequestReturnType returnType)
 EMPTYP thing
 EMPTY? thing
 
-    outputs TRUE if the input is the empty word or the empty list,
-    FALSE otherwise.
+    outputs TRUE if the input is the empty word, the empty list, or a
+    dictionary with no keys, FALSE otherwise.
 
 COD***/
 // CMD EMPTYP 1 1 1 b
@@ -795,7 +992,8 @@ MEMBER? thing1 thing2
     if "thing2" is a list or an array, outputs TRUE if "thing1" is EQUALP
     to a member of "thing2", FALSE otherwise.  If "thing2" is
     a word, outputs TRUE if "thing1" is a one-character word EQUALP to a
-    character of "thing2", FALSE otherwise.
+    character of "thing2", FALSE otherwise.  If "thing2" is a dictionary,
+    outputs TRUE if "thing1" is one of its keys, FALSE otherwise.
 
 COD***/
 // CMD MEMBERP 2 2 2 b
@@ -879,7 +1077,8 @@ COUNT thing
     outputs the number of characters in the input, if the input is a word;
     outputs the number of members in the input, if it is a list
     or an array.  (For an array, this may or may not be the index of the
-    last member, depending on the array's origin.)
+    last member, depending on the array's origin.)  Outputs the number of
+    keys in the input, if it is a dictionary.
 
 COD***/
 // CMD COUNT 1 1 1 n
@@ -987,6 +1186,22 @@ Value *Compiler::genMember(const DatumPtr &node, RequestReturnType returnType)
     thing2 = generateFromDatum(Datum::typeWordOrListMask, node.astnodeValue(), thing2);
     return generateCallExtern(TyAddr, member, PaAddr(evaluator), PaAddr(thing1), PaAddr(thing2));
 }
+/***DOC REMDUP
+REMDUP list
+
+    outputs a copy of "list" with duplicate members removed.  If two or
+    more members of the input are equal, the rightmost of those members
+    is the one that remains in the output.
+
+COD***/
+// CMD REMDUP 1 1 1 d
+Value *Compiler::genRemdup(const DatumPtr &node, RequestReturnType returnType)
+{
+    Q_ASSERT(returnType && RequestReturnDatum);
+    Value *thing = generateChild(node.astnodeValue(), 0, RequestReturnDatum);
+    thing = generateFromDatum(Datum::typeWordOrListMask, node.astnodeValue(), thing);
+    return generateCallExtern(TyAddr, removeDuplicates, PaAddr(evaluator), PaAddr(thing));
+}
 /***DOC LOWERCASE
 LOWERCASE word
 
@@ -1069,3 +1284,115 @@ Value *Compiler::genRunparse(const DatumPtr &node, RequestReturnType returnType)
     wordorlist = generateFromDatum(Datum::typeWordOrListMask, node.astnodeValue(), wordorlist);
     return generateCallExtern(TyAddr, runparseDatum, PaAddr(evaluator), PaAddr(wordorlist));
 }
+
+/***DOC DICTIONARY
+DICTIONARY
+
+    outputs a new, empty dictionary.  A dictionary maps keys to values.
+    A key may be any datum; two keys are the same if they are EQUALP,
+    so words are compared according to CASEIGNOREDP.  Unlike a property
+    list, a dictionary is a datum: it can be the value of a variable,
+    a member of a list, or an input to a procedure.  A dictionary is
+    printed as its keys and values, in the order the keys were added,
+    between angle brackets: <key1 value1 key2 value2>.
+
+    COUNT outputs the number of keys in a dictionary, EMPTYP outputs TRUE
+    if it has none, and MEMBERP outputs TRUE if its first input is one of
+    the keys.  A list that is changed (with .SETFIRST, .SETBF or SETITEM)
+    after it is used as a key may no longer be found.
+
+COD***/
+// CMD DICTIONARY 0 0 0 d
+Value *Compiler::genDictionary(const DatumPtr &node, RequestReturnType returnType)
+{
+    Q_ASSERT(returnType && RequestReturnDatum);
+    return generateCallExtern(TyAddr, createDictionary, PaAddr(evaluator));
+}
+
+/***DOC DICTPUT
+DICTPUT dictionary key value
+
+    command.  Makes "value" the value of "key" in "dictionary", replacing
+    the value the key had, if any.
+
+COD***/
+// CMD DICTPUT 3 3 3 n
+Value *Compiler::genDictput(const DatumPtr &node, RequestReturnType returnType)
+{
+    Q_ASSERT(returnType && RequestReturnNothing);
+    Value *dict = generateChild(node.astnodeValue(), 0, RequestReturnDatum);
+    Value *key = generateChild(node.astnodeValue(), 1, RequestReturnDatum);
+    Value *value = generateChild(node.astnodeValue(), 2, RequestReturnDatum);
+    dict = generateDictionaryFromDatum(node.astnodeValue(), dict);
+    generateCallExtern(TyVoid, dictionaryPut, PaAddr(evaluator), PaAddr(dict), PaAddr(key), PaAddr(value));
+    return generateVoidRetval(node);
+}
+
+/***DOC DICTGET
+DICTGET dictionary key
+
+    outputs the value of "key" in "dictionary", or the empty list if
+    the dictionary has no such key.
+
+COD***/
+// CMD DICTGET 2 2 2 d
+Value *Compiler::genDictget(const DatumPtr &node, RequestReturnType returnType)
+{
+    Q_ASSERT(returnType && RequestReturnDatum);
+    Value *dict = generateChild(node.astnodeValue(), 0, RequestReturnDatum);
+    Value *key = generateChild(node.astnodeValue(), 1, RequestReturnDatum);
+    dict = generateDictionaryFromDatum(node.astnodeValue(), dict);
+    return generateCallExtern(TyAddr, dictionaryGet, PaAddr(evaluator), PaAddr(dict), PaAddr(key));
+}
+
+/***DOC DICTREMOVE
+DICTREMOVE dictionary key
+
+    command.  Removes "key" and its value from "dictionary".  Does
+    nothing if the dictionary has no such key.
+
+COD***/
+// CMD DICTREMOVE 2 2 2 n
+Value *Compiler::genDictremove(const DatumPtr &node, RequestReturnType returnType)
+{
+    Q_ASSERT(returnType && RequestReturnNothing);
+    Value *dict = generateChild(node.astnodeValue(), 0, RequestReturnDatum);
+    Value *key = generateChild(node.astnodeValue(), 1, RequestReturnDatum);
+    dict = generateDictionaryFromDatum(node.astnodeValue(), dict);
+    generateCallExtern(TyVoid, dictionaryRemove, PaAddr(evaluator), PaAddr(dict), PaAddr(key));
+    return generateVoidRetval(node);
+}
+
+/***DOC DICTKEYS
+DICTKEYS dictionary
+
+    outputs a list of the keys of "dictionary", in the order they were
+    added.
+
+COD***/
+// CMD DICTKEYS 1 1 1 d
+Value *Compiler::genDictkeys(const DatumPtr &node, RequestReturnType returnType)
+{
+    Q_ASSERT(returnType && RequestReturnDatum);
+    Value *dict = generateChild(node.astnodeValue(), 0, RequestReturnDatum);
+    dict = generateDictionaryFromDatum(node.astnodeValue(), dict);
+    return generateCallExtern(TyAddr, dictionaryKeys, PaAddr(evaluator), PaAddr(dict));
+}
+
+/***DOC DICTIONARYP DICTIONARY?
+DICTIONARYP thing
+DICTIONARY? thing
+
+    outputs TRUE if the input is a dictionary, FALSE otherwise.
+
+COD***/
+// CMD DICTIONARYP 1 1 1 b
+// CMD DICTIONARY? 1 1 1 b
+Value *Compiler::genDictionaryp(const DatumPtr &node, RequestReturnType returnType)
+{
+    Q_ASSERT(returnType && RequestReturnDatum);
+    Value *thing = generateChild(node.astnodeValue(), 0, RequestReturnDatum);
+    Value *thingType = generateGetDatumIsa(thing);
+    Value *isType = scaff->builder.CreateICmpEQ(thingType, CoInt32(Datum::typeDictionary), "isDatumTypeCond");
+    return scaff->builder.CreateSelect(isType, CoBool(true), CoBool(false), "isDatumTypeResult");
+}
@@ -63,6 +63,40 @@ Value *Compiler::genBack(const DatumPtr &node, RequestReturnType returnType)
     generateCallExtern(TyVoid, moveTurtleForward, PaDouble(distance));
     return generateVoidRetval(node);
 }
+
+Value *Compiler::generateStepArray(ASTNode *node, Value *&count)
+{
+    // The children are the signed steps, all literals.
+    std::vector<Value *> steps = generateChildren(node, RequestReturnReal);
+    count = CoInt32(steps.size());
+    Value *offset = CoInt64(sizeof(double));
+    AllocaInst *stepAry = scaff->builder.CreateAlloca(TyDouble, count, DBG_NAME("stepAry"));
+    Value *stepPtr = stepAry;
+    for (int i = 0; i < steps.size(); ++i)
+    {
+        scaff->builder.CreateStore(steps[i], stepPtr);
+        if (i < steps.size() - 1)
+            stepPtr = scaff->builder.CreatePtrAdd(stepPtr, offset, DBG_NAME("stepIncr"));
+    }
+    return stepAry;
+}
+
+Value *Compiler::genMergedForward(const DatumPtr &node, RequestReturnType returnType)
+{
+    Value *count;
+    Value *stepAry = generateStepArray(node.astnodeValue(), count);
+    generateCallExtern(TyVoid, moveTurtleForwardSteps, PaAddr(stepAry), PaInt32(count));
+    return generateVoidRetval(node);
+}
+
+Value *Compiler::genMergedRight(const DatumPtr &node, RequestReturnType returnType)
+{
+    Value *count;
+    Value *stepAry = generateStepArray(node.astnodeValue(), count);
+    generateCallExtern(TyVoid, moveTurtleRotateSteps, PaAddr(stepAry), PaInt32(count));
+    return generateVoidRetval(node);
+}
+
 /***DOC LEFT LT
 LEFT degrees
 LT degrees
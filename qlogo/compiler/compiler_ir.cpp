@@ -0,0 +1,575 @@
+//===-- qlogo/compiler_ir.cpp - Logo-level IR implementation -------*- C++ -*-===//
+//
+// Copyright 2017-2024 Jason Sikes
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the conditions specified in the
+// license found in the LICENSE file in the project root.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the LogoIR class, the Logo-level
+/// intermediate representation, and its optimization passes.
+///
+//===----------------------------------------------------------------------===//
+
+#include "compiler_ir.h"
+#include "astnode.h"
+#include "cmd_strings.h"
+#include "compiler.h"
+#include "datum_types.h"
+#include "op_strings.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace
+{
+
+/// Primitives that do not write variables and do not run Logo code. Variable
+/// reads remain valid across these.
+bool isPureGenerator(Generator g)
+{
+    static const Generator pureGenerators[] = {
+        &Compiler::genSum,       &Compiler::genDifference, &Compiler::genProduct,   &Compiler::genQuotient,
+        &Compiler::genRemainder, &Compiler::genModulo,     &Compiler::genMinus,     &Compiler::genSqrt,
+        &Compiler::genPower,     &Compiler::genInt,        &Compiler::genRound,     &Compiler::genSin,
+        &Compiler::genCos,       &Compiler::genArctan,     &Compiler::genExp,       &Compiler::genLn,
+        &Compiler::genLog10,     &Compiler::genRadsin,     &Compiler::genRadcos,    &Compiler::genRadarctan,
+        &Compiler::genLessp,     &Compiler::genGreaterp,   &Compiler::genLessequalp, &Compiler::genGreaterequalp,
+        &Compiler::genEqualp,    &Compiler::genNotequalp,  &Compiler::genNot,       &Compiler::genWord,
+        &Compiler::genList,      &Compiler::genSentence,   &Compiler::genFput,      &Compiler::genLput,
+        &Compiler::genFirst,     &Compiler::genLast,       &Compiler::genButfirst,  &Compiler::genButlast,
+        &Compiler::genItem,      &Compiler::genCount,      &Compiler::genWordp,     &Compiler::genListp,
+        &Compiler::genArrayp,    &Compiler::genNumberp,    &Compiler::genEmptyp,    &Compiler::genMemberp,
+        &Compiler::genMember,    &Compiler::genBeforep,    &Compiler::genAscii,     &Compiler::genChar,
+        &Compiler::genLowercase, &Compiler::genUppercase,
+    };
+    return std::find(std::begin(pureGenerators), std::end(pureGenerators), g) != std::end(pureGenerators);
+}
+
+/// Pure primitives whose output may be a part of an input, rather than a new value. A read
+/// that feeds one of these is in use for as long as the output is.
+bool isPartOfInputGenerator(Generator g)
+{
+    return (g == &Compiler::genFirst) || (g == &Compiler::genLast) || (g == &Compiler::genButfirst) ||
+           (g == &Compiler::genButlast) || (g == &Compiler::genItem) || (g == &Compiler::genMember);
+}
+
+DatumPtr literalNode(const QString &nodeType, const DatumPtr &value)
+{
+    auto *node = new ASTNode(nodeType);
+    node->genExpression = &Compiler::genLiteral;
+    node->returnType = RequestReturnDatum;
+    node->addChild(value);
+    return DatumPtr(node);
+}
+
+} // namespace
+
+LogoIR::LogoIR(const QList<QList<DatumPtr>> &parsedList) : blocks(parsedList)
+{
+    int valueNumber = 0;
+    for (int block = 0; block < blocks.size(); ++block)
+    {
+        blockBase.append(valueNumber);
+        instructions.append(QList<LogoIRInstruction>());
+        deadStatements.append(QSet<int>());
+        for (int statement = 0; statement < blocks[block].size(); ++statement)
+        {
+            build(block, statement, blocks[block][statement], nullptr, 0);
+        }
+        valueNumber += instructions[block].size();
+    }
+}
+
+int LogoIR::build(int block, int statement, const DatumPtr &node, ASTNode *parent, int childIndex)
+{
+    ASTNode *astnode = node.astnodeValue();
+    Generator g = astnode->genExpression;
+
+    LogoIRInstruction instruction;
+    instruction.node = node;
+    instruction.parent = parent;
+    instruction.childIndex = childIndex;
+    instruction.statement = statement;
+
+    if (g == &Compiler::genLiteral)
+    {
+        instruction.opcode = LogoIRInstruction::opLiteral;
+    }
+    else if (g == &Compiler::genValueOf)
+    {
+        instruction.opcode = LogoIRInstruction::opVarRead;
+        instruction.name = astnode->childAtIndex(0).toString(Datum::ToStringFlags_Key);
+    }
+    else
+    {
+        // Inputs are evaluated before the node that consumes them.
+        for (int i = 0; i < astnode->countOfChildren(); ++i)
+        {
+            DatumPtr child = astnode->childAtIndex(i);
+            if (child.isASTNode())
+                instruction.operands.append(build(block, statement, child, astnode, i));
+        }
+
+        instruction.opcode = LogoIRInstruction::opCall;
+        if (g == &Compiler::genTag)
+        {
+            instruction.opcode = LogoIRInstruction::opTag;
+        }
+        else if (g == &Compiler::genRepeat)
+        {
+            instruction.opcode = LogoIRInstruction::opRepeat;
+        }
+        else if ((g == &Compiler::genForward) || (g == &Compiler::genBack))
+        {
+            instruction.opcode = LogoIRInstruction::opMove;
+        }
+        else if ((g == &Compiler::genRight) || (g == &Compiler::genLeft))
+        {
+            instruction.opcode = LogoIRInstruction::opTurn;
+        }
+        else if (g == &Compiler::genMake)
+        {
+            // Only a MAKE with a literal name is a known write. Otherwise, we must
+            // assume that it may write to any variable.
+            DatumPtr nameNode = astnode->childAtIndex(0);
+            if ((nameNode.astnodeValue()->genExpression == &Compiler::genLiteral) &&
+                nameNode.astnodeValue()->childAtIndex(0).isWord())
+            {
+                instruction.opcode = LogoIRInstruction::opVarWrite;
+                instruction.name = nameNode.astnodeValue()->childAtIndex(0).toString(Datum::ToStringFlags_Key);
+            }
+        }
+        else if (isPureGenerator(g))
+        {
+            instruction.opcode = LogoIRInstruction::opPureCall;
+        }
+    }
+
+    instructions[block].append(instruction);
+    return blockBase[block] + instructions[block].size() - 1;
+}
+
+LogoIRInstruction &LogoIR::instructionAt(int valueNumber)
+{
+    int block = blockBase.size() - 1;
+    while (blockBase[block] > valueNumber)
+        --block;
+    return instructions[block][valueNumber - blockBase[block]];
+}
+
+bool LogoIR::isNumberLiteral(int valueNumber, double &value)
+{
+    const LogoIRInstruction &instruction = instructionAt(valueNumber);
+    if (instruction.opcode != LogoIRInstruction::opLiteral)
+        return false;
+    DatumPtr literal = instruction.node.astnodeValue()->childAtIndex(0);
+    if (!literal.isWord())
+        return false;
+    value = literal.wordValue()->numberValue();
+    return literal.wordValue()->numberIsValid;
+}
+
+void LogoIR::replaceNode(int block, LogoIRInstruction &instruction, const DatumPtr &newNode)
+{
+    if (instruction.parent == nullptr)
+        blocks[block][instruction.statement] = newNode;
+    else
+        instruction.parent->replaceChild(instruction.childIndex, newNode);
+    instruction.node = newNode;
+}
+
+void LogoIR::optimize()
+{
+    hoistConstantCalls();
+    eliminateCommonReads();
+    eliminateDeadMakes();
+    mergeTurtleMoves();
+    findPinnedReads();
+
+    // Now that the passes no longer need the statement indices, remove the dead statements.
+    for (int block = 0; block < blocks.size(); ++block)
+    {
+        QList<int> dead = deadStatements[block].values();
+        std::sort(dead.begin(), dead.end(), std::greater<int>());
+        for (int statement : dead)
+        {
+            blocks[block].removeAt(statement);
+        }
+    }
+}
+
+// The body of a REPEAT is compiled once and run many times, so a pure call with
+// literal inputs is worth evaluating here rather than on every iteration.
+void LogoIR::hoistConstantCalls()
+{
+    for (int block = 0; block < instructions.size(); ++block)
+    {
+        for (auto &instruction : instructions[block])
+        {
+            if ((instruction.opcode != LogoIRInstruction::opPureCall) || instruction.operands.isEmpty())
+                continue;
+            Generator g = instruction.node.astnodeValue()->genExpression;
+
+            if (g == &Compiler::genWord)
+            {
+                QString result;
+                bool isFoldable = true;
+                for (int operand : instruction.operands)
+                {
+                    const LogoIRInstruction &input = instructionAt(operand);
+                    if ((input.opcode != LogoIRInstruction::opLiteral) ||
+                        !input.node.astnodeValue()->childAtIndex(0).isWord())
+                    {
+                        isFoldable = false;
+                        break;
+                    }
+                    result += input.node.astnodeValue()->childAtIndex(0).toString(Datum::ToStringFlags_Raw);
+                }
+                if (!isFoldable)
+                    continue;
+                replaceNode(block, instruction, literalNode(StringConstants::astNodeTypeQuotedWord(), DatumPtr(result)));
+            }
+            else
+            {
+                QList<double> inputs;
+                for (int operand : instruction.operands)
+                {
+                    double value;
+                    if (!isNumberLiteral(operand, value))
+                        break;
+                    inputs.append(value);
+                }
+                if (inputs.size() != instruction.operands.size())
+                    continue;
+
+                double result;
+                if (g == &Compiler::genSum)
+                {
+                    result = 0;
+                    for (double input : inputs)
+                        result += input;
+                }
+                else if (g == &Compiler::genProduct)
+                {
+                    result = 1;
+                    for (double input : inputs)
+                        result *= input;
+                }
+                else if ((g == &Compiler::genDifference) && (inputs.size() == 2))
+                {
+                    result = inputs[0] - inputs[1];
+                }
+                else if ((g == &Compiler::genMinus) && (inputs.size() == 1))
+                {
+                    result = -inputs[0];
+                }
+                else if ((g == &Compiler::genQuotient) && (inputs.last() != 0))
+                {
+                    result = (inputs.size() == 1) ? 1 / inputs[0] : inputs[0] / inputs[1];
+                }
+                else
+                {
+                    continue;
+                }
+                if (!std::isfinite(result))
+                    continue;
+                replaceNode(block, instruction, literalNode(StringConstants::astNodeTypeNumber(), DatumPtr(result)));
+            }
+
+            for (int operand : instruction.operands)
+            {
+                instructionAt(operand).isDead = true;
+            }
+            instruction.operands.clear();
+            instruction.opcode = LogoIRInstruction::opLiteral;
+        }
+    }
+}
+
+// Every node of a block is generated in order into straight-line code, so the value
+// of a read dominates every later node of the same block. A TAG always begins a new
+// block, so a value is never reused across a jump target.
+void LogoIR::eliminateCommonReads()
+{
+    for (int block = 0; block < instructions.size(); ++block)
+    {
+        QHash<QString, int> available;
+        for (int i = 0; i < instructions[block].size(); ++i)
+        {
+            LogoIRInstruction &instruction = instructions[block][i];
+            if (instruction.isDead)
+                continue;
+            switch (instruction.opcode)
+            {
+            case LogoIRInstruction::opVarRead:
+            {
+                auto source = available.find(instruction.name);
+                if (source == available.end())
+                {
+                    available.insert(instruction.name, blockBase[block] + i);
+                }
+                else
+                {
+                    instruction.replacement = *source;
+                    readSources.insert(instruction.node.astnodeValue(),
+                                       instructionAt(*source).node.astnodeValue());
+                }
+                break;
+            }
+            case LogoIRInstruction::opVarWrite:
+                available.remove(instruction.name);
+                break;
+            case LogoIRInstruction::opCall:
+            case LogoIRInstruction::opRepeat:
+            case LogoIRInstruction::opTag:
+                available.clear();
+                break;
+            default:
+                break;
+            }
+        }
+    }
+}
+
+// A MAKE is dead if the same variable is written again before anything can read it
+// or before anything can fail (an error would let the user see the first value).
+void LogoIR::eliminateDeadMakes()
+{
+    for (int block = 0; block < instructions.size(); ++block)
+    {
+        QList<LogoIRInstruction> &list = instructions[block];
+        for (int i = 0; i < list.size(); ++i)
+        {
+            const LogoIRInstruction &write = list[i];
+            if ((write.opcode != LogoIRInstruction::opVarWrite) || write.isDead || (write.parent != nullptr) ||
+                (write.operands.size() != 2))
+                continue;
+
+            // The value must be free of side effects and unable to fail, since it will
+            // not be computed at all.
+            const LogoIRInstruction &value = instructionAt(write.operands[1]);
+            if ((value.opcode != LogoIRInstruction::opLiteral) && (value.replacement == -1))
+                continue;
+
+            for (int j = i + 1; j < list.size(); ++j)
+            {
+                const LogoIRInstruction &next = list[j];
+                if (next.isDead || (next.opcode == LogoIRInstruction::opLiteral))
+                    continue;
+                if ((next.opcode == LogoIRInstruction::opVarRead) && (next.replacement != -1) &&
+                    (next.name != write.name))
+                    continue;
+                if ((next.opcode == LogoIRInstruction::opVarWrite) && (next.name == write.name) &&
+                    (next.parent == nullptr))
+                {
+                    for (int k = i; k >= 0 && list[k].statement == write.statement; --k)
+                    {
+                        list[k].isDead = true;
+                    }
+                    deadStatements[block].insert(write.statement);
+                }
+                break;
+            }
+        }
+    }
+}
+
+void LogoIR::mergeTurtleMoves()
+{
+    for (int block = 0; block < instructions.size(); ++block)
+    {
+        QList<LogoIRInstruction> &list = instructions[block];
+
+        // The root of each statement is its last instruction.
+        QList<int> roots;
+        for (int i = 0; i < list.size(); ++i)
+        {
+            if ((i == list.size() - 1) || (list[i + 1].statement != list[i].statement))
+            {
+                if (!deadStatements[block].contains(list[i].statement))
+                    roots.append(i);
+            }
+        }
+
+        int runStart = 0;
+        while (runStart < roots.size())
+        {
+            LogoIRInstruction &first = list[roots[runStart]];
+            double step;
+            if (((first.opcode != LogoIRInstruction::opMove) && (first.opcode != LogoIRInstruction::opTurn)) ||
+                (first.operands.size() != 1) || !isNumberLiteral(first.operands[0], step))
+            {
+                ++runStart;
+                continue;
+            }
+
+            // Collect the signed steps. A run of moves must all go the same way so that
+            // the turtle never retraces a line that the merged move would not draw.
+            Generator g = first.node.astnodeValue()->genExpression;
+            bool isNegated = (g == &Compiler::genBack) || (g == &Compiler::genLeft);
+            QList<double> steps = {isNegated ? -step : step};
+            double direction = steps.first();
+            int runEnd = runStart + 1;
+            while (runEnd < roots.size())
+            {
+                const LogoIRInstruction &next = list[roots[runEnd]];
+                if ((next.opcode != first.opcode) || (next.operands.size() != 1) ||
+                    !isNumberLiteral(next.operands[0], step))
+                    break;
+                g = next.node.astnodeValue()->genExpression;
+                isNegated = (g == &Compiler::genBack) || (g == &Compiler::genLeft);
+                step = isNegated ? -step : step;
+                if ((first.opcode == LogoIRInstruction::opMove) && (step * direction < 0))
+                    break;
+                if (direction == 0)
+                    direction = step;
+                steps.append(step);
+                ++runEnd;
+            }
+
+            if (steps.size() > 1)
+            {
+                // The turns are kept as separate steps, since turning by their sum would
+                // not round the same way.
+                ASTNode *merged;
+                if (first.opcode == LogoIRInstruction::opMove)
+                {
+                    merged = new ASTNode(StringConstants::cmdStrFORWARD());
+                    merged->genExpression = &Compiler::genMergedForward;
+                }
+                else
+                {
+                    merged = new ASTNode(StringConstants::cmdStrRIGHT());
+                    merged->genExpression = &Compiler::genMergedRight;
+                }
+                for (double s : steps)
+                {
+                    merged->addChild(literalNode(StringConstants::astNodeTypeNumber(), DatumPtr(s)));
+                }
+                merged->returnType = RequestReturnNothing;
+                replaceNode(block, first, DatumPtr(merged));
+
+                // The merged node holds its steps directly, not as instructions.
+                instructionAt(first.operands.first()).isDead = true;
+                first.operands.clear();
+                for (int r = runStart + 1; r < runEnd; ++r)
+                {
+                    for (int k = roots[r]; k >= 0 && list[k].statement == list[roots[r]].statement; --k)
+                    {
+                        list[k].isDead = true;
+                    }
+                    deadStatements[block].insert(list[roots[r]].statement);
+                }
+            }
+            runStart = runEnd;
+        }
+    }
+}
+
+// The value of a read is a borrowed reference to the variable's value. Instructions are
+// numbered in the order they run, so those between a read and the instruction that
+// consumes it (or consumes a part of it) run while the value is in use. If any of them
+// may run Logo code, that code could free the value or change it in place.
+void LogoIR::findPinnedReads()
+{
+    for (int block = 0; block < instructions.size(); ++block)
+    {
+        const QList<LogoIRInstruction> &list = instructions[block];
+        QHash<int, int> consumers;
+        for (int i = 0; i < list.size(); ++i)
+        {
+            if (list[i].isDead)
+                continue;
+            for (int operand : list[i].operands)
+                consumers.insert(operand - blockBase[block], i);
+        }
+
+        for (int i = 0; i < list.size(); ++i)
+        {
+            if (list[i].isDead || (list[i].opcode != LogoIRInstruction::opVarRead))
+                continue;
+            int holder = i;
+            while (consumers.contains(holder) &&
+                   isPartOfInputGenerator(list[consumers[holder]].node.astnodeValue()->genExpression))
+                holder = consumers[holder];
+            int end = consumers.value(holder, holder);
+            for (int j = i + 1; j < end; ++j)
+            {
+                const LogoIRInstruction &next = list[j];
+                if (next.isDead || (next.opcode == LogoIRInstruction::opLiteral) ||
+                    (next.opcode == LogoIRInstruction::opVarRead) || (next.opcode == LogoIRInstruction::opPureCall))
+                    continue;
+                pinnedReads.insert(list[i].node.astnodeValue());
+                break;
+            }
+        }
+    }
+}
+
+QString LogoIR::toString() const
+{
+    QString retval;
+    for (int block = 0; block < instructions.size(); ++block)
+    {
+        retval += QString("block %1:\n").arg(block);
+        for (int i = 0; i < instructions[block].size(); ++i)
+        {
+            const LogoIRInstruction &instruction = instructions[block][i];
+            ASTNode *astnode = instruction.node.astnodeValue();
+            QString line = QString("  %%1 = ").arg(blockBase[block] + i);
+            switch (instruction.opcode)
+            {
+            case LogoIRInstruction::opLiteral:
+                line += "literal " + astnode->childAtIndex(0).toString(Datum::ToStringFlags_Show);
+                break;
+            case LogoIRInstruction::opVarRead:
+                line += "read " + instruction.name;
+                if (instruction.replacement != -1)
+                    line += QString(" = %%1").arg(instruction.replacement);
+                break;
+            case LogoIRInstruction::opVarWrite:
+                line += "write " + instruction.name;
+                break;
+            case LogoIRInstruction::opPureCall:
+                line += "purecall " + astnode->nodeName.toString();
+                break;
+            case LogoIRInstruction::opCall:
+                line += "call " + astnode->nodeName.toString();
+                break;
+            case LogoIRInstruction::opRepeat:
+                line += "repeat";
+                break;
+            case LogoIRInstruction::opMove:
+                line += "move " + astnode->nodeName.toString();
+                break;
+            case LogoIRInstruction::opTurn:
+                line += "turn " + astnode->nodeName.toString();
+                break;
+            case LogoIRInstruction::opTag:
+                line += "tag";
+                break;
+            }
+            for (int operand : instruction.operands)
+            {
+                line += QString(" %%1").arg(operand);
+            }
+            // A merged move or turn holds its steps directly, not as instructions.
+            if (((instruction.opcode == LogoIRInstruction::opMove) || (instruction.opcode == LogoIRInstruction::opTurn)) &&
+                instruction.operands.isEmpty())
+            {
+                for (int c = 0; c < astnode->countOfChildren(); ++c)
+                {
+                    line += " " + astnode->childAtIndex(c).astnodeValue()->childAtIndex(0).toString();
+                }
+            }
+            if (instruction.isDead)
+                line += "    ; dead";
+            retval += line + "\n";
+        }
+    }
+    return retval;
+}
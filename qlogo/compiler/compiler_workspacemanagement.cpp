@@ -145,6 +145,41 @@ Value *Compiler::genInputProcedure(const DatumPtr &node, RequestReturnType retur
     return generateCallExtern(TyAddr, inputProcedure, PaAddr(evaluator), PaAddr(CoAddr(node.datumValue())));
 }
 
+/// @brief Return the literal word of a node, or nothing if the node isn't a literal word.
+static const DatumPtr &literalWordOfNode(const DatumPtr &node)
+{
+    if (node.isASTNode() && (node.astnodeValue()->genExpression == &Compiler::genLiteral))
+    {
+        const DatumPtr &literal = node.astnodeValue()->childAtIndex(0);
+        if (literal.isWord())
+            return literal;
+    }
+    return nothing();
+}
+
+/// @brief Return the node, if any, among the inputs of valueNode that reads the list input
+/// of a list operation that MAKE may perform in place, i.e. :L in LPUT x :L, SENTENCE :L x,
+/// or BUTLAST :L.
+static const DatumPtr &listReadOfNode(const DatumPtr &valueNode)
+{
+    if (!valueNode.isASTNode())
+        return nothing();
+    ASTNode *node = valueNode.astnodeValue();
+    Generator g = node->genExpression;
+    int listIndex = -1;
+    if ((g == &Compiler::genLput) && (node->countOfChildren() == 2))
+        listIndex = 1;
+    else if (((g == &Compiler::genSentence) || (g == &Compiler::genButlast)) && (node->countOfChildren() > 0))
+        listIndex = 0;
+    if (listIndex < 0)
+        return nothing();
+
+    const DatumPtr &listNode = node->childAtIndex(listIndex);
+    if (listNode.isASTNode() && (listNode.astnodeValue()->genExpression == &Compiler::genValueOf))
+        return listNode;
+    return nothing();
+}
+
 /***DOC MAKE
 MAKE varname value
 
@@ -160,7 +195,32 @@ Value *Compiler::genMake(const DatumPtr &node, RequestReturnType returnType)
     Q_ASSERT(returnType && RequestReturnNothing);
 
     Value *varname = generateChild(node.astnodeValue(), 0, RequestReturnDatum);
+
+    // If the value is computed as a number (e.g. by arithmetic), store it without creating a Word.
+    const DatumPtr &valueNode = node.astnodeValue()->childAtIndex(1);
+    if (valueNode.isASTNode() && (valueNode.astnodeValue()->returnType == RequestReturnReal))
+    {
+        Value *value = generateChild(node.astnodeValue(), 1, RequestReturnReal);
+        varname = generateFromDatum(Datum::typeWord, node.astnodeValue(), varname);
+        generateCallExtern(TyVoid, setDoubleForWord, PaDouble(value), PaAddr(varname));
+        return generateVoidRetval(node);
+    }
+
+    // MAKE "L LPUT :X :L, and the like, may change the list in place, since the variable
+    // that holds it is about to be given the changed list.
+    const DatumPtr &name = literalWordOfNode(node.astnodeValue()->childAtIndex(0));
+    const DatumPtr &listRead = listReadOfNode(valueNode);
+    if (name.isWord() && listRead.isASTNode() &&
+        (listRead.astnodeValue()->childAtIndex(0).toString(Datum::ToStringFlags_Key) ==
+         name.toString(Datum::ToStringFlags_Key)))
+    {
+        inPlaceListNode = valueNode.astnodeValue();
+        inPlaceVarName = name.wordValue();
+    }
+
     Value *value = generateChild(node.astnodeValue(), 1, RequestReturnDatum);
+    inPlaceListNode = nullptr;
+    inPlaceVarName = nullptr;
     varname = generateFromDatum(Datum::typeWord, node.astnodeValue(), varname);
 
     generateCallExtern(TyVoid, setDatumForWord, PaAddr(value), PaAddr(varname));
@@ -195,3 +255,238 @@ Value *Compiler::genLocal(const DatumPtr &node, RequestReturnType returnType)
 
     return generateVoidRetval(node);
 }
+
+Value *Compiler::generatePropertyListName(ASTNode *parent, unsigned int index)
+{
+    if (literalWordOfNode(parent->childAtIndex(index)).isWord())
+        return nullptr;
+
+    Value *nameValue = generateChild(parent, index, RequestReturnDatum);
+    return generateWordFromDatum(parent, nameValue);
+}
+
+Value *Compiler::generatePropertyList(ASTNode *parent, unsigned int index, Value *nameValue, bool isCreating)
+{
+    PropertyLists &plists = Kernel::get().plists;
+    if (nameValue == nullptr)
+    {
+        const DatumPtr &name = literalWordOfNode(parent->childAtIndex(index));
+        PropertyLists::PropertyList *plist =
+            isCreating ? plists.propertyListForName(name) : plists.findPropertyList(name);
+        if (plist != nullptr)
+        {
+            plist->isPinned = true;
+            return CoAddr(plist);
+        }
+        // Not known yet, so it is looked up each time.
+        nameValue = CoAddr(name.datumValue());
+    }
+    if (isCreating)
+        return generateCallExtern(TyAddr, propertyListForWord, PaAddr(nameValue));
+    return generateCallExtern(TyAddr, findPropertyListForWord, PaAddr(nameValue));
+}
+
+Value *Compiler::generatePropertySymbol(ASTNode *parent, unsigned int index, bool isCreating)
+{
+    PropertyLists &plists = Kernel::get().plists;
+    const DatumPtr &name = literalWordOfNode(parent->childAtIndex(index));
+    Value *nameValue;
+    if (name.isWord())
+    {
+        int symbol = isCreating ? plists.symbolForPropertyName(name) : plists.findSymbol(name);
+        if (symbol >= 0)
+            return CoInt32(symbol);
+        // Not known yet, so it is looked up each time.
+        nameValue = CoAddr(name.datumValue());
+    }
+    else
+    {
+        nameValue = generateChild(parent, index, RequestReturnDatum);
+        nameValue = generateWordFromDatum(parent, nameValue);
+    }
+    if (isCreating)
+        return generateCallExtern(TyInt32, propertySymbolForWord, PaAddr(nameValue));
+    return generateCallExtern(TyInt32, findPropertySymbolForWord, PaAddr(nameValue));
+}
+
+/***DOC PPROP
+PPROP plistname propname value
+
+    command.  Adds a property to the "plistname" property list
+    with name "propname" and value "value".
+
+COD***/
+// CMD PPROP 3 3 3 n
+Value *Compiler::genPprop(const DatumPtr &node, RequestReturnType returnType)
+{
+    Q_ASSERT(returnType && RequestReturnNothing);
+    Value *plistName = generatePropertyListName(node.astnodeValue(), 0);
+    Value *propSymbol = generatePropertySymbol(node.astnodeValue(), 1, true);
+    Value *value = generateChild(node.astnodeValue(), 2, RequestReturnDatum);
+    Value *plist = generatePropertyList(node.astnodeValue(), 0, plistName, true);
+    generateCallExtern(TyVoid, setPropertyOfList, PaAddr(plist), PaInt32(propSymbol), PaAddr(value));
+    return generateVoidRetval(node);
+}
+
+/***DOC GPROP
+GPROP plistname propname
+
+    outputs the value of the "propname" property in the "plistname"
+    property list, or the empty list if there is no such property.
+
+COD***/
+// CMD GPROP 2 2 2 d
+Value *Compiler::genGprop(const DatumPtr &node, RequestReturnType returnType)
+{
+    Q_ASSERT(returnType && RequestReturnDatum);
+    Value *plistName = generatePropertyListName(node.astnodeValue(), 0);
+    Value *propSymbol = generatePropertySymbol(node.astnodeValue(), 1, false);
+    Value *plist = generatePropertyList(node.astnodeValue(), 0, plistName, false);
+    return generateCallExtern(TyAddr, getPropertyOfList, PaAddr(evaluator), PaAddr(plist), PaInt32(propSymbol));
+}
+
+/***DOC REMPROP
+REMPROP plistname propname
+
+    command.  Removes the property named "propname" from the
+    property list named "plistname".
+
+COD***/
+// CMD REMPROP 2 2 2 n
+Value *Compiler::genRemprop(const DatumPtr &node, RequestReturnType returnType)
+{
+    Q_ASSERT(returnType && RequestReturnNothing);
+    Value *plistName = generatePropertyListName(node.astnodeValue(), 0);
+    Value *propSymbol = generatePropertySymbol(node.astnodeValue(), 1, false);
+    Value *plist = generatePropertyList(node.astnodeValue(), 0, plistName, false);
+    generateCallExtern(TyVoid, removePropertyOfList, PaAddr(plist), PaInt32(propSymbol));
+    return generateVoidRetval(node);
+}
+
+/***DOC PLIST
+PLIST plistname
+
+    outputs a list whose odd-numbered members are the names, and
+    whose even-numbered members are the values, of the properties
+    in the property list named "plistname".  The output is a copy
+    of the actual property list; changing properties later will not
+    magically change a list output earlier by PLIST.
+
+COD***/
+// CMD PLIST 1 1 1 d
+Value *Compiler::genPlist(const DatumPtr &node, RequestReturnType returnType)
+{
+    Q_ASSERT(returnType && RequestReturnDatum);
+    Value *plistName = generatePropertyListName(node.astnodeValue(), 0);
+    Value *plist = generatePropertyList(node.astnodeValue(), 0, plistName, false);
+    return generateCallExtern(TyAddr, getPropertyListOfList, PaAddr(evaluator), PaAddr(plist));
+}
+
+/***DOC PLISTP PLIST?
+PLISTP name
+PLIST? name
+
+    outputs TRUE if the input is the name of a *nonempty* property list.
+    (In principle every word is the name of a property list; if you haven't
+    put any properties in it, PLIST of that name outputs an empty list,
+    rather than giving an error message.)
+
+COD***/
+// CMD PLISTP 1 1 1 b
+// CMD PLIST? 1 1 1 b
+Value *Compiler::genPlistp(const DatumPtr &node, RequestReturnType returnType)
+{
+    Q_ASSERT(returnType && RequestReturnBool);
+    Value *plistName = generatePropertyListName(node.astnodeValue(), 0);
+    Value *plist = generatePropertyList(node.astnodeValue(), 0, plistName, false);
+    return generateCallExtern(TyBool, isPropertyListNotEmpty, PaAddr(plist));
+}
+
+/***DOC NODES
+NODES
+
+    outputs a list of two numbers.  The first represents the number of
+    nodes of memory currently in use.  The second shows the maximum
+    number of nodes that have been in use at any time since the last
+    invocation of NODES.  (A node is a small block of computer memory
+    as used by Logo.  Each word (string or number) uses one node. Each list
+    or array uses one node plus more nodes for the elements.  Numbers
+    and TRUE or FALSE held in a list or array don't use a node of their own.)
+
+COD***/
+// CMD NODES 0 0 0 d
+Value *Compiler::genNodes(const DatumPtr &node, RequestReturnType returnType)
+{
+    Q_ASSERT(returnType && RequestReturnDatum);
+    return generateCallExtern(TyAddr, nodeCounts, PaAddr(evaluator));
+}
+
+/***DOC HEAPSTATS
+HEAPSTATS
+
+    outputs a list of lists describing the memory used by Logo.  Each of
+    the first eight members has the form [kind count bytes], giving the
+    number of nodes of that kind currently in use and the bytes they
+    occupy, for the kinds WORD, LIST, ARRAY, DICTIONARY, PROCEDURE,
+    ASTNODE (a parsed instruction), FLOWCONTROL and OTHER.  Then come
+
+        [unpooled count bytes]  nodes too large for the node allocator,
+                                which are not included in the kinds above
+        [total count bytes]     all nodes in use
+        [peak count bytes]      the most nodes and bytes in use at once
+                                since the last invocation of NODES
+        [collected runs count bytes]  how many times the collector of
+                                circular lists has run, and the nodes and
+                                bytes it has reclaimed
+
+COD***/
+// CMD HEAPSTATS 0 0 0 d
+Value *Compiler::genHeapstats(const DatumPtr &node, RequestReturnType returnType)
+{
+    Q_ASSERT(returnType && RequestReturnDatum);
+    return generateCallExtern(TyAddr, heapStats, PaAddr(evaluator));
+}
+
+/***DOC HEAPSNAPSHOT
+HEAPSNAPSHOT
+
+    outputs a list with one member for each variable that has a value and
+    each nonempty property list, of the form [variable name nodes bytes]
+    or [plist name nodes bytes].  "nodes" is the number of words, lists
+    and arrays reachable from the value (or, for a property list, from the
+    values of all its properties), and "bytes" is the memory they occupy.
+    The members are sorted with the largest first.  Data reachable from
+    more than one variable is counted for each of them.
+
+COD***/
+// CMD HEAPSNAPSHOT 0 0 0 d
+Value *Compiler::genHeapsnapshot(const DatumPtr &node, RequestReturnType returnType)
+{
+    Q_ASSERT(returnType && RequestReturnDatum);
+    return generateCallExtern(TyAddr, heapSnapshot, PaAddr(evaluator));
+}
+
+/***DOC ALLOCATIONS
+ALLOCATIONS
+
+    outputs a list with one member for each instruction that has allocated
+    objects (words, lists, arrays, procedures, parsed instructions and so
+    on), of the form
+
+        [procedure instruction count bytes]
+
+    where "procedure" is the procedure that was running (or "(toplevel)"),
+    "instruction" is the name of the primitive or procedure called, and
+    "count" and "bytes" are the number of objects it has allocated and
+    their size.  The members are sorted with the most bytes
+    first.  The counts are kept only if QLogo was started with the
+    --profileAllocations option, which also prints them when QLogo exits.
+    Otherwise, ALLOCATIONS outputs an empty list.
+
+COD***/
+// CMD ALLOCATIONS 0 0 0 d
+Value *Compiler::genAllocations(const DatumPtr &node, RequestReturnType returnType)
+{
+    Q_ASSERT(returnType && RequestReturnDatum);
+    return generateCallExtern(TyAddr, allocationReport, PaAddr(evaluator));
+}
@@ -0,0 +1,107 @@
+//===-- qlogo/allocation_profiler.cpp - AllocationProfiler class implementation -------*- C++ -*-===//
+//
+// Copyright 2017-2024 Jason Sikes
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the conditions specified in the
+// license found in the LICENSE file in the project root.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the AllocationProfiler class, which
+/// attributes every Datum that is allocated to the instruction and procedure
+/// that allocated it.
+///
+//===----------------------------------------------------------------------===//
+
+#include "allocation_profiler.h"
+#include "astnode.h"
+#include "datum_types.h"
+#include "workspace/kernel.h"
+#include <QObject>
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+QString instructionName(const DatumPtr &node)
+{
+    return node.isASTNode() ? node.astnodeValue()->nodeName.toString() : QObject::tr("(none)");
+}
+
+QString procedureName(const DatumPtr &procedure)
+{
+    return procedure.isWord() ? procedure.toString() : QObject::tr("(toplevel)");
+}
+} // namespace
+
+void AllocationProfiler::record(size_t size)
+{
+    const Datum *key = siteStack.isEmpty() ? nullptr : siteStack.last();
+    auto it = sites.find(key);
+    if (it == sites.end())
+    {
+        Site site;
+        // Only compiled code enters sites, so the Kernel, and its call stack, exists.
+        if (key != nullptr)
+        {
+            site.node = DatumPtr(const_cast<Datum *>(key));
+            const CallFrameStack &callStack = Kernel::get().callStack;
+            if ((callStack.size() > 0) && callStack.localFrame()->sourceNode.isASTNode())
+                site.procedure = callStack.localFrame()->sourceNode.astnodeValue()->nodeName;
+        }
+        it = sites.insert(key, site);
+    }
+    ++it->count;
+    it->bytes += size;
+}
+
+void AllocationProfiler::leave(const Datum *node)
+{
+    while (!siteStack.isEmpty())
+    {
+        if (siteStack.takeLast() == node)
+            break;
+    }
+}
+
+QList<AllocationProfiler::Site> AllocationProfiler::sortedSites() const
+{
+    // A copy, so that building a report, which allocates and so adds to the counts,
+    // doesn't change the table being read.
+    QList<Site> retval = sites.values();
+    std::stable_sort(retval.begin(), retval.end(), [](const Site &a, const Site &b) {
+        return a.bytes > b.bytes;
+    });
+    return retval;
+}
+
+DatumPtr AllocationProfiler::report() const
+{
+    ListBuilder builder;
+    for (const Site &site : sortedSites())
+    {
+        ListBuilder siteBuilder;
+        siteBuilder.append(DatumPtr(procedureName(site.procedure)));
+        siteBuilder.append(DatumPtr(instructionName(site.node)));
+        siteBuilder.append(DatumPtr(static_cast<double>(site.count)));
+        siteBuilder.append(DatumPtr(static_cast<double>(site.bytes)));
+        builder.append(siteBuilder.finishedList());
+    }
+    return builder.finishedList();
+}
+
+void AllocationProfiler::printReport() const
+{
+    fprintf(stderr, "%-24s %-24s %12s %14s\n", "PROCEDURE", "INSTRUCTION", "COUNT", "BYTES");
+    for (const Site &site : sortedSites())
+    {
+        fprintf(stderr,
+                "%-24s %-24s %12zu %14zu\n",
+                procedureName(site.procedure).toUtf8().constData(),
+                instructionName(site.node).toUtf8().constData(),
+                site.count,
+                site.bytes);
+    }
+}
@@ -0,0 +1,230 @@
+//===-- qlogo/cycle_collector.cpp - CycleCollector class implementation -------*- C++ -*-===//
+//
+// Copyright 2017-2024 Jason Sikes
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the conditions specified in the
+// license found in the LICENSE file in the project root.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the CycleCollector class, a backup
+/// collector for reference cycles among Lists, Arrays and Dictionaries.
+///
+//===----------------------------------------------------------------------===//
+
+#include "cycle_collector.h"
+#include "datum_types.h"
+#include "sharedconstants.h"
+#include <QHash>
+#include <qdebug.h>
+
+namespace
+{
+enum Color
+{
+    gray,  // Visited; references from within the subgraph have been subtracted.
+    black, // Live.
+    white, // Garbage.
+};
+
+/// @brief Return the datum p refers to if it is a List, Array or Dictionary, otherwise nullptr.
+Datum *containerOf(const DatumPtr &p)
+{
+    if (p.isImmediate())
+        return nullptr;
+    Datum *d = p.datumValue();
+    if ((d->isa == Datum::typeList) || (d->isa == Datum::typeArray) || (d->isa == Datum::typeDictionary))
+        return d;
+    return nullptr;
+}
+
+/// @brief Call f with each List, Array or Dictionary that d refers to.
+template <typename F> void forEachChild(Datum *d, F f)
+{
+    if (d->isa == Datum::typeList)
+    {
+        auto *l = static_cast<List *>(d);
+        if (Datum *child = containerOf(l->head))
+            f(child);
+        if (Datum *child = containerOf(l->tail))
+            f(child);
+        return;
+    }
+
+    if (d->isa == Datum::typeDictionary)
+    {
+        auto *dict = static_cast<Dictionary *>(d);
+        for (const auto &entry : dict->entries)
+        {
+            if (Datum *child = containerOf(entry.key))
+                f(child);
+            if (Datum *child = containerOf(entry.value))
+                f(child);
+        }
+        return;
+    }
+
+    auto *a = static_cast<Array *>(d);
+    for (const auto &item : a->array)
+    {
+        if (Datum *child = containerOf(item))
+            f(child);
+    }
+}
+
+size_t sizeOfContainer(Datum *d)
+{
+    if (d->isa == Datum::typeList)
+        return sizeof(List);
+    if (d->isa == Datum::typeDictionary)
+    {
+        auto *dict = static_cast<Dictionary *>(d);
+        return sizeof(Dictionary) + dict->entries.capacity() * sizeof(Dictionary::Entry);
+    }
+    auto *a = static_cast<Array *>(d);
+    return sizeof(Array) + a->array.capacity() * sizeof(DatumPtr);
+}
+} // namespace
+
+void CycleCollector::addSuspect(Datum *d)
+{
+    if (Config::get().cycleCollectorThreshold == 0)
+        return;
+    d->isSuspect = true;
+    suspects.insert(d);
+}
+
+void CycleCollector::forget(Datum *d)
+{
+    suspects.remove(d);
+    d->isSuspect = false;
+}
+
+bool CycleCollector::isCollectionDue() const
+{
+    int threshold = Config::get().cycleCollectorThreshold;
+    return (threshold > 0) && (suspects.size() >= threshold);
+}
+
+void CycleCollector::collect()
+{
+    QHash<Datum *, Color> colors;
+    // The retain count of each visited container, less the references held by gray containers.
+    QHash<Datum *, int> counts;
+    QList<Datum *> stack;
+
+    QList<Datum *> roots;
+    roots.reserve(suspects.size());
+    for (Datum *d : suspects)
+    {
+        d->isSuspect = false;
+        // A datum with no references is an Evaluator's return value on its way to the caller.
+        if (d->retainCount > 0)
+            roots.append(d);
+    }
+    suspects.clear();
+
+    // Mark gray: subtract every reference held within the subgraph reachable from the suspects.
+    // The traversals use an explicit stack since lists can be very long.
+    for (Datum *root : roots)
+    {
+        if (colors.contains(root))
+            continue;
+        colors.insert(root, gray);
+        counts.insert(root, root->retainCount);
+        stack.append(root);
+        while (!stack.isEmpty())
+        {
+            forEachChild(stack.takeLast(), [&](Datum *child) {
+                auto count = counts.find(child);
+                if (count == counts.end())
+                    count = counts.insert(child, child->retainCount);
+                --count.value();
+                if (!colors.contains(child))
+                {
+                    colors.insert(child, gray);
+                    stack.append(child);
+                }
+            });
+        }
+    }
+
+    // Scan: a container with a reference from outside the subgraph is live, and so is
+    // everything it refers to. Restore the references held by live containers.
+    auto scanBlack = [&](Datum *start) {
+        colors[start] = black;
+        stack.append(start);
+        while (!stack.isEmpty())
+        {
+            forEachChild(stack.takeLast(), [&](Datum *child) {
+                ++counts[child];
+                if (colors.value(child) != black)
+                {
+                    colors[child] = black;
+                    stack.append(child);
+                }
+            });
+        }
+    };
+    QList<Datum *> scanStack;
+    for (Datum *root : roots)
+    {
+        scanStack.append(root);
+        while (!scanStack.isEmpty())
+        {
+            Datum *d = scanStack.takeLast();
+            if (colors.value(d) != gray)
+                continue;
+            if (counts.value(d) > 0)
+            {
+                scanBlack(d);
+                continue;
+            }
+            colors[d] = white;
+            forEachChild(d, [&](Datum *child) { scanStack.append(child); });
+        }
+    }
+
+    // Collect white: what remains is only referenced from within garbage cycles.
+    QList<Datum *> garbage;
+    size_t bytes = 0;
+    for (auto it = colors.cbegin(); it != colors.cend(); ++it)
+    {
+        if (it.value() == white)
+        {
+            garbage.append(it.key());
+            bytes += sizeOfContainer(it.key());
+        }
+    }
+
+    // Hold each garbage container so that none is destroyed while the cycles are broken.
+    for (Datum *d : garbage)
+        ++(d->retainCount);
+    for (Datum *d : garbage)
+    {
+        if (d->isa == Datum::typeList)
+            static_cast<List *>(d)->clear();
+        else if (d->isa == Datum::typeDictionary)
+            static_cast<Dictionary *>(d)->clear();
+        else
+            static_cast<Array *>(d)->array.clear();
+    }
+    for (Datum *d : garbage)
+    {
+        --(d->retainCount);
+        Q_ASSERT(d->retainCount == 0);
+        if (d->retainCount == 0)
+            delete d;
+    }
+
+    ++countOfCollections;
+    countOfObjectsCollected += garbage.size();
+    countOfBytesCollected += bytes;
+
+    if (Config::get().showGC)
+        qDebug() << "cycle collector: scanned" << roots.size() << "suspects, freed" << garbage.size()
+                 << "objects and" << bytes << "bytes;" << countOfBytesCollected << "bytes freed in"
+                 << countOfCollections << "collections";
+}
@@ -15,9 +15,16 @@
 ///
 //===----------------------------------------------------------------------===//
 
+#include "allocation_profiler.h"
+#include "astnode.h"
+#include "cycle_collector.h"
 #include "datum_core.h"
+#include "datum_pool.h"
+#include "datum_types.h"
+#include "flowcontrol.h"
 #include "sharedconstants.h"
 #include <QObject>
+#include <QQueue>
 #include <algorithm>
 #include <qdebug.h>
 #include <unistd.h>
@@ -27,7 +34,9 @@ int countOfNodes = 0;
 /// @brief The maximum number of Datum objects that have ever been in use.
 int maxCountOfNodes = 0;
 
-Datum::Datum()
+static_assert(sizeof(Datum) == 16, "The Datum header should be the vtable pointer and one 64-bit word");
+
+Datum::Datum() : retainCount(0), alertOnDelete(false), isSuspect(false)
 {
     ++countOfNodes;
     maxCountOfNodes = std::max(maxCountOfNodes, countOfNodes);
@@ -43,12 +52,117 @@ Datum *Datum::notADatum()
 
 Datum::~Datum()
 {
+    if (isSuspect)
+        CycleCollector::get().forget(this);
     --countOfNodes;
     if (Config::get().showCON)
         qDebug() << this << " --con: " << countOfNodes;
 }
 
+namespace
+{
+/// @brief Datums whose last reference was released while another datum was being deleted.
+struct PendingDeletes
+{
+    QQueue<Datum *> queue;
+    bool isDeleting = false;
+};
+
+PendingDeletes &pendingDeletes()
+{
+    // Never destroyed, since Datums may be released during static destruction.
+    static auto *instance = new PendingDeletes;
+    return *instance;
+}
+/// @brief Delete d. Words, Lists and Arrays, which are nearly everything that is deleted,
+/// are destroyed without going through the vtable.
+void destroy(Datum *d)
+{
+    switch (d->isa)
+    {
+    case Datum::typeWord:
+        delete static_cast<Word *>(d); // Word is final.
+        return;
+    case Datum::typeArray:
+        delete static_cast<Array *>(d); // Array is final.
+        return;
+    case Datum::typeList:
+        // The only subclass of List is EmptyList, whose one instance is never deleted.
+        static_cast<List *>(d)->List::~List();
+        Datum::operator delete(d, sizeof(List));
+        return;
+    default:
+        delete d;
+        return;
+    }
+}
+} // namespace
+
+void Datum::deleteUnreferenced(Datum *d)
+{
+    PendingDeletes &pending = pendingDeletes();
+    if (pending.isDeleting)
+    {
+        pending.queue.append(d);
+        return;
+    }
+
+    pending.isDeleting = true;
+    destroy(d);
+    // Deleting in queue order keeps the queue short: deleting a list cell queues its
+    // element and then the next cell, so the element goes before the cell after that.
+    while (!pending.queue.isEmpty())
+        destroy(pending.queue.dequeue());
+    pending.isDeleting = false;
+}
+
+void *Datum::operator new(size_t size)
+{
+    // Counted here rather than in the constructors, so that a Datum made on the stack
+    // isn't taken for an allocation.
+    AllocationProfiler::allocated(size);
+    return DatumPool::get().allocate(size);
+}
+
+void Datum::operator delete(void *p, size_t size)
+{
+    DatumPool::get().deallocate(p, size);
+}
+
+int Datum::liveNodeCount()
+{
+    return countOfNodes;
+}
+
+int Datum::maxLiveNodeCount()
+{
+    return maxCountOfNodes;
+}
+
+void Datum::resetMaxLiveNodeCount()
+{
+    maxCountOfNodes = countOfNodes;
+}
+
 QString Datum::toString(ToStringFlags flags, int printDepthLimit, int printWidthLimit, VisitedSet *visited) const
 {
-    return QObject::tr("nothing");
+    switch (isa)
+    {
+    case typeWord:
+        return static_cast<const Word *>(this)->toString(flags, printDepthLimit, printWidthLimit, visited);
+    case typeList:
+        return static_cast<const List *>(this)->toString(flags, printDepthLimit, printWidthLimit, visited);
+    case typeEmptyList:
+        return static_cast<const EmptyList *>(this)->toString(flags, printDepthLimit, printWidthLimit, visited);
+    case typeArray:
+        return static_cast<const Array *>(this)->toString(flags, printDepthLimit, printWidthLimit, visited);
+    case typeDictionary:
+        return static_cast<const Dictionary *>(this)->toString(flags, printDepthLimit, printWidthLimit, visited);
+    case typeASTNode:
+        return static_cast<const ASTNode *>(this)->toString(flags, printDepthLimit, printWidthLimit, visited);
+    case typeError:
+        return static_cast<const FCError *>(this)->toString(flags, printDepthLimit, printWidthLimit, visited);
+    default:
+        return QObject::tr("nothing");
+    }
 }
@@ -28,11 +28,16 @@ int ASTNode::countOfChildren() const
     return (int)children.size();
 }
 
-DatumPtr ASTNode::childAtIndex(unsigned index) const
+const DatumPtr &ASTNode::childAtIndex(unsigned index) const
 {
     return children.at(index);
 }
 
+void ASTNode::replaceChild(unsigned index, const DatumPtr &aChild)
+{
+    children[index] = aChild;
+}
+
 ASTNode::ASTNode(const DatumPtr &aNodeName)
 {
     isa = Datum::typeASTNode;
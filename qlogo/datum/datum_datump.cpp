@@ -17,80 +17,120 @@
 //===----------------------------------------------------------------------===//
 
 #include "astnode.h"
+#include "cycle_collector.h"
 #include "datum_types.h"
 #include "workspace/procedures.h"
 #include <QObject>
+#include <cmath>
+#include <cstring>
 #include <qdebug.h>
 
-bool isNotPersistent(Datum *d)
+static_assert(sizeof(void *) == sizeof(quint64), "Immediate values require 64-bit pointers");
+
+namespace
+{
+/// @brief Return true if the bits refer to a Datum that is reference-counted.
+bool isNotPersistent(quint64 bits)
 {
+    if ((bits >> 48) != 0)
+        return false; // immediate
+    auto *d = reinterpret_cast<Datum *>(bits);
     return (d != nullptr) && ((d->isa & Datum::typePersistentMask) == 0);
 }
+} // namespace
 
-DatumPtr::DatumPtr() : d(Datum::notADatum())
+DatumPtr::DatumPtr() : bits(reinterpret_cast<quint64>(Datum::notADatum()))
 {
 }
 
 DatumPtr::DatumPtr(Datum *other) noexcept
 {
-    d = other;
-    if (isNotPersistent(d))
+    bits = reinterpret_cast<quint64>(other);
+    if (isNotPersistent(bits))
     {
-        ++(d->retainCount);
+        ++(other->retainCount);
     }
 }
 
 DatumPtr::DatumPtr(const DatumPtr &other) noexcept
 {
-    d = other.d;
-    if (isNotPersistent(d))
+    bits = other.bits;
+    if (isNotPersistent(bits))
     {
-        ++(d->retainCount);
+        ++(pointer()->retainCount);
     }
 }
 
+DatumPtr::DatumPtr(DatumPtr &&other) noexcept : bits(other.bits)
+{
+    other.bits = reinterpret_cast<quint64>(Datum::notADatum());
+}
+
 DatumPtr::DatumPtr(bool b)
 {
-    d = new Word(b ? QObject::tr("true") : QObject::tr("false"));
-    ++(d->retainCount);
+    bits = immediateBoolTag | (b ? 1 : 0);
 }
 
 DatumPtr::DatumPtr(double n)
 {
-    d = new Word(n);
-    ++(d->retainCount);
+    if (std::isnan(n))
+    {
+        Datum *d = new Word(n);
+        ++(d->retainCount);
+        bits = reinterpret_cast<quint64>(d);
+        return;
+    }
+    std::memcpy(&bits, &n, sizeof(bits));
+    bits += immediateDoubleOffset;
 }
 
-DatumPtr::DatumPtr(int n)
+DatumPtr::DatumPtr(int n) : DatumPtr(static_cast<double>(n))
 {
-    d = new Word((double)n);
-    ++(d->retainCount);
 }
 
 DatumPtr::DatumPtr(const QString &n, bool isVBarred)
 {
-    d = new Word(n, isVBarred);
+    Datum *d = new Word(n, isVBarred);
     ++(d->retainCount);
+    bits = reinterpret_cast<quint64>(d);
 }
 
 DatumPtr::DatumPtr(const char *n)
 {
-    d = new Word(QString(n));
+    Datum *d = new Word(QString(n));
     ++(d->retainCount);
+    bits = reinterpret_cast<quint64>(d);
+}
+
+void DatumPtr::box() const
+{
+    Q_ASSERT(isImmediate());
+    Word *w;
+    if (isImmediateBool())
+        w = new Word((bits & 1) ? QObject::tr("true") : QObject::tr("false"));
+    else
+        w = new Word(immediateNumber());
+    ++(w->retainCount);
+    bits = reinterpret_cast<quint64>(static_cast<Datum *>(w));
 }
 
 void DatumPtr::destroy()
 {
-    if (isNotPersistent(d))
+    if (isNotPersistent(bits))
     {
+        Datum *d = pointer();
         --(d->retainCount);
-        if (d->retainCount <= 0)
+        if (d->retainCount == 0)
         {
             if (d->alertOnDelete)
             {
                 qDebug() << "DELETING: " << d << " " << d->toString(Datum::ToStringFlags_Show);
             }
-            delete d;
+            Datum::deleteUnreferenced(d);
+        }
+        else
+        {
+            CycleCollector::released(d);
         }
     }
 }
@@ -104,66 +144,88 @@ DatumPtr &DatumPtr::operator=(const DatumPtr &other) noexcept
 {
     if (&other != this)
     {
-        destroy();
-        d = other.d;
-        if (isNotPersistent(d))
+        // Retain first, in case other refers to something that only this keeps alive.
+        if (isNotPersistent(other.bits))
         {
-            ++(d->retainCount);
+            ++(other.pointer()->retainCount);
         }
+        destroy();
+        bits = other.bits;
+    }
+    return *this;
+}
+
+DatumPtr &DatumPtr::operator=(DatumPtr &&other) noexcept
+{
+    if (&other != this)
+    {
+        // Take other's bits before releasing ours, in case other lives inside what we release.
+        quint64 incoming = other.bits;
+        other.bits = reinterpret_cast<quint64>(Datum::notADatum());
+        destroy();
+        bits = incoming;
     }
     return *this;
 }
 
 bool DatumPtr::operator==(const DatumPtr &other) const
 {
-    return d == other.d;
+    return bits == other.bits;
 }
 
 bool DatumPtr::operator!=(const DatumPtr &other) const
 {
-    return d != other.d;
+    return bits != other.bits;
 }
 
 Word *DatumPtr::wordValue() const
 {
-    Q_ASSERT(d->isa == Datum::typeWord);
-    return reinterpret_cast<Word *>(d);
+    if (isImmediate())
+        box();
+    Q_ASSERT(pointer()->isa == Datum::typeWord);
+    return reinterpret_cast<Word *>(pointer());
 }
 
 List *DatumPtr::listValue() const
 {
-    Q_ASSERT(d && (d->isa & Datum::typeList) != 0);
-    return reinterpret_cast<List *>(d);
+    Q_ASSERT(!isImmediate() && (pointer()->isa & Datum::typeList) != 0);
+    return reinterpret_cast<List *>(pointer());
 }
 
 Array *DatumPtr::arrayValue() const
 {
-    Q_ASSERT(d->isa == Datum::typeArray);
-    return reinterpret_cast<Array *>(d);
+    Q_ASSERT(!isImmediate() && pointer()->isa == Datum::typeArray);
+    return reinterpret_cast<Array *>(pointer());
+}
+
+Dictionary *DatumPtr::dictionaryValue() const
+{
+    Q_ASSERT(!isImmediate() && pointer()->isa == Datum::typeDictionary);
+    return reinterpret_cast<Dictionary *>(pointer());
 }
 
 FlowControl *DatumPtr::flowControlValue() const
 {
-    Q_ASSERT((d->isa & Datum::typeFlowControlMask) != 0);
-    return reinterpret_cast<FlowControl *>(d);
+    Q_ASSERT(!isImmediate() && (pointer()->isa & Datum::typeFlowControlMask) != 0);
+    return reinterpret_cast<FlowControl *>(pointer());
 }
 
 Procedure *DatumPtr::procedureValue() const
 {
-    Q_ASSERT(d->isa == Datum::typeProcedure);
-    return reinterpret_cast<Procedure *>(d);
+    Q_ASSERT(!isImmediate() && pointer()->isa == Datum::typeProcedure);
+    return reinterpret_cast<Procedure *>(pointer());
 }
 
 ASTNode *DatumPtr::astnodeValue() const
 {
-    Q_ASSERT(d->isa == Datum::typeASTNode);
-    return reinterpret_cast<ASTNode *>(d);
+    Q_ASSERT(!isImmediate() && pointer()->isa == Datum::typeASTNode);
+    return reinterpret_cast<ASTNode *>(pointer());
 }
 
 FCError *DatumPtr::errValue() const
 {
-    Q_ASSERT(d->isa == Datum::typeError);
-    return reinterpret_cast<FCError *>(d);
+    Q_ASSERT(!isImmediate() && pointer()->isa == Datum::typeError);
+    return reinterpret_cast<FCError *>(pointer());
 }
 
 QString DatumPtr::toString(Datum::ToStringFlags flags,
@@ -171,7 +233,15 @@ QString DatumPtr::toString(Datum::ToStringFlags flags,
                            int printWidthLimit,
                            VisitedSet *visited) const
 {
-    return d->toString(flags, printDepthLimit, printWidthLimit, visited);
+    if (isImmediate())
+    {
+        // Format through a temporary Word so that the output matches a boxed value exactly.
+        if (isImmediateBool())
+            return Word((bits & 1) ? QObject::tr("true") : QObject::tr("false"))
+                .toString(flags, printDepthLimit, printWidthLimit, visited);
+        return Word(immediateNumber()).toString(flags, printDepthLimit, printWidthLimit, visited);
+    }
+    return pointer()->toString(flags, printDepthLimit, printWidthLimit, visited);
 }
 
 // Value to represent nothing (similar to nullptr)
@@ -0,0 +1,117 @@
+//===-- qlogo/datum_dictionary.cpp - Dictionary class implementation --*- C++ -*-===//
+//
+// Copyright 2017-2024 Jason Sikes
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the conditions specified in the
+// license found in the LICENSE file in the project root.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the Dictionary class.
+/// A dictionary maps keys, which may be words, lists or arrays, to values.
+///
+//===----------------------------------------------------------------------===//
+
+#include "datum_types.h"
+#include "workspace/visited.h"
+#include <memory>
+
+Dictionary::Dictionary()
+{
+    isa = Datum::typeDictionary;
+}
+
+Dictionary::~Dictionary() = default;
+
+void Dictionary::insert(const DatumPtr &key, quint32 hash, const DatumPtr &value)
+{
+    indexesByHash.insert(hash, entries.size());
+    entries.append({key, value, hash});
+}
+
+void Dictionary::removeAt(qsizetype index)
+{
+    Entry &entry = entries[index];
+    indexesByHash.remove(entry.hash, index);
+    entry.key = nothing();
+    entry.value = nothing();
+    ++countOfRemoved;
+
+    // Compact once most of the entries are removed ones, so that removing keys one at a
+    // time costs amortized O(1) and the order of the remaining keys is kept.
+    if (countOfRemoved * 2 <= entries.size())
+        return;
+    QList<Entry> kept;
+    kept.reserve(count());
+    indexesByHash.clear();
+    for (Entry &e : entries)
+    {
+        if (e.key.isNothing())
+            continue;
+        indexesByHash.insert(e.hash, kept.size());
+        kept.append(std::move(e));
+    }
+    entries = std::move(kept);
+    countOfRemoved = 0;
+}
+
+void Dictionary::clear()
+{
+    indexesByHash.clear();
+    entries.clear();
+    countOfRemoved = 0;
+}
+
+QString Dictionary::toString(ToStringFlags flags, int printDepthLimit, int printWidthLimit, VisitedSet *visited) const
+{
+    if (count() == 0)
+    {
+        return "<>";
+    }
+
+    std::unique_ptr<VisitedSet> localVisited;
+    if (visited == nullptr)
+    {
+        localVisited = std::make_unique<VisitedSet>();
+        visited = localVisited.get();
+    }
+
+    if ((printDepthLimit == 0) || (visited->contains(this)))
+    {
+        return "<...>";
+    }
+
+    visited->add(this);
+    int printWidth = printWidthLimit;
+
+    // Any words within a collection don't need to be formatted as source code.
+    flags = (Datum::ToStringFlags)(flags & ~(Datum::ToStringFlags_Source));
+    // Any lists within a collection need to show their brackets.
+    flags = (Datum::ToStringFlags)(flags | Datum::ToStringFlags_Show);
+
+    // Each key is followed by its value, as in a property list.
+    QString retval = "<";
+    bool isFirst = true;
+    for (const Entry &entry : entries)
+    {
+        if (entry.key.isNothing())
+            continue;
+        if (!isFirst)
+            retval.append(' ');
+        isFirst = false;
+        if (printWidth == 0)
+        {
+            retval.append("...");
+            break;
+        }
+        retval.append(entry.key.toString(flags, printDepthLimit - 1, printWidthLimit, visited));
+        retval.append(' ');
+        retval.append(entry.value.toString(flags, printDepthLimit - 1, printWidthLimit, visited));
+        --printWidth;
+    }
+    retval.append(">");
+    visited->remove(this);
+    return retval;
+}
@@ -20,16 +20,30 @@
 #include "datum_types.h"
 #include "treeifyer.h"
 #include "workspace/visited.h"
+#include <QHash>
 #include <QObject>
 #include <qdebug.h>
 
 List::List(const DatumPtr &item, List *srcList)
 {
     isa = Datum::typeList;
+    hasCachedHash = false;
+    isKnownUnique = false;
+    hasStaleCells = false;
+    cacheEpoch = 0;
     head = item;
     tail = DatumPtr(srcList);
 }
 
+List::List(DatumPtr &&item, List *srcList) : head(std::move(item)), tail(srcList)
+{
+    isa = Datum::typeList;
+    hasCachedHash = false;
+    isKnownUnique = false;
+    hasStaleCells = false;
+    cacheEpoch = 0;
+}
+
 List::~List()
 {
     try
@@ -125,7 +139,56 @@ void List::clear()
     compileTimeStamp = 0;
 }
 
+quint64 List::structureEpoch = 1;
+
 int List::count() const
+{
+    if (this == EmptyList::instance())
+        return 0;
+    if (cacheEpoch == structureEpoch)
+        return cachedCount;
+
+    // Walk to the end of the list, or to the first cell with a valid count. Brent's
+    // algorithm catches a circular list without keeping a set of the visited cells.
+    int uncounted = 0;
+    const List *iter = this;
+    const List *last = this;
+    const List *checkpoint = this;
+    int steps = 0;
+    int stepLimit = 1;
+    while ((iter != EmptyList::instance()) && (iter->cacheEpoch != structureEpoch))
+    {
+        ++uncounted;
+        last = iter;
+        iter = iter->tail.listValue();
+        if (iter == checkpoint)
+            return countWithCycle();
+        if (++steps == stepLimit)
+        {
+            checkpoint = iter;
+            stepLimit *= 2;
+            steps = 0;
+        }
+    }
+
+    int total = uncounted;
+    if (iter != EmptyList::instance())
+    {
+        total += iter->cachedCount;
+        last = iter->cachedLast;
+    }
+
+    // Now cache the count in each of the cells that were walked.
+    iter = this;
+    for (int remaining = total; uncounted > 0; --uncounted, --remaining)
+    {
+        iter->cacheCount(remaining, last);
+        iter = iter->tail.listValue();
+    }
+    return total;
+}
+
+int List::countWithCycle() const
 {
     int retval = 0;
     const List *iter = this;
@@ -145,6 +208,188 @@ int List::count() const
     return retval;
 }
 
+const List *List::lastCell() const
+{
+    if (this == EmptyList::instance())
+        return nullptr;
+    count();
+    return (cacheEpoch == structureEpoch) ? cachedLast : nullptr;
+}
+
+namespace
+{
+
+/// @brief The number of cells of nested sublists that each member of a list may walk
+/// while its hash is computed.
+constexpr int nestedHashLimit = 256;
+
+constexpr quint32 emptyListHash = 0x6A09E667U;
+
+/// @brief The hash of a circular list, and of whatever a sublist holds past the limit.
+constexpr quint32 unhashedListHash = 0xBB67AE85U;
+
+quint32 combineHashes(quint32 elementHash, quint32 tailHash)
+{
+    return tailHash ^ (elementHash + 0x9E3779B9U + (tailHash << 6) + (tailHash >> 2));
+}
+
+} // namespace
+
+quint32 List::structuralHash() const
+{
+    return hashOfCells(nullptr);
+}
+
+quint32 List::structuralHashOf(const DatumPtr &element)
+{
+    if (element.isList())
+        return element.listValue()->structuralHash();
+    int budget = nestedHashLimit;
+    return hashOfElement(element, budget);
+}
+
+quint32 List::hashOfElement(const DatumPtr &element, int &budget)
+{
+    if (element.isImmediateNumber())
+        return Word::hashOfNumber(element.immediateNumber());
+    if (element.isImmediate())
+        return Word::hashOfString(element.toString());
+    if (element.isWord())
+        return element.wordValue()->structuralHash();
+    if (element.isList())
+        return (budget > 0) ? element.listValue()->hashOfCells(&budget) : unhashedListHash;
+    return static_cast<quint32>(qHash(element.datumValue()));
+}
+
+/// The hash of each cell combines the hash of its head with the hash of its tail, so the
+/// cells are walked to the end (or to a cell with a cached hash) and then hashed in
+/// reverse. A list hashed at the top level, i.e. with no budget, caches its hashes and
+/// gives each member its own budget for nested sublists. A sublist spends the budget it
+/// was given, one cell at a time.
+quint32 List::hashOfCells(int *budget) const
+{
+    if (this == EmptyList::instance())
+        return emptyListHash;
+
+    bool isTopLevel = (budget == nullptr);
+    if (isTopLevel)
+    {
+        if (hasStaleCells)
+            clearStaleCells();
+        if (hasCachedHash && (cacheEpoch == structureEpoch))
+            return cachedHash;
+        // A circular list has no end to hash back from.
+        if (lastCell() == nullptr)
+            return unhashedListHash;
+    }
+
+    QList<std::pair<const List *, quint32>> cells;
+    quint32 hash = emptyListHash;
+    const List *iter = this;
+    while (iter != EmptyList::instance())
+    {
+        if (isTopLevel)
+        {
+            if (iter->hasCachedHash && (iter->cacheEpoch == structureEpoch))
+            {
+                hash = iter->cachedHash;
+                break;
+            }
+            int elementBudget = nestedHashLimit;
+            cells.append({iter, hashOfElement(iter->head, elementBudget)});
+        }
+        else
+        {
+            if (*budget <= 0)
+            {
+                hash = unhashedListHash;
+                break;
+            }
+            --*budget;
+            cells.append({iter, hashOfElement(iter->head, *budget)});
+        }
+        iter = iter->tail.listValue();
+    }
+
+    for (auto i = cells.size(); i > 0; --i)
+    {
+        const auto &[cell, elementHash] = cells[i - 1];
+        hash = combineHashes(elementHash, hash);
+        if (isTopLevel)
+        {
+            cell->cachedHash = hash;
+            cell->hasCachedHash = true;
+        }
+    }
+    return hash;
+}
+
+bool List::isUnique(int holders) const
+{
+    if ((this == EmptyList::instance()) || (retainCount != holders))
+        return false;
+    if (isKnownUnique)
+        return true;
+
+    // A circular list refers to its own first cell.
+    if (lastCell() == nullptr)
+        return false;
+    for (const List *iter = tail.listValue(); iter != EmptyList::instance(); iter = iter->tail.listValue())
+    {
+        if (iter->retainCount != 1)
+            return false;
+    }
+    isKnownUnique = true;
+    return true;
+}
+
+void List::clearStaleCells() const
+{
+    for (const List *iter = tail.listValue(); iter != EmptyList::instance(); iter = iter->tail.listValue())
+    {
+        iter->cacheEpoch = 0;
+        iter->hasCachedHash = false;
+    }
+    hasStaleCells = false;
+}
+
+void List::appendInPlace(const DatumPtr &aList)
+{
+    Q_ASSERT(isKnownUnique);
+    const List *first = aList.listValue();
+    if (first == EmptyList::instance())
+        return;
+
+    int newCount = count() + first->count();
+    const List *newLast = first->lastCell();
+    // Safe: this list is unique, so nothing else can see its last cell.
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    const_cast<List *>(lastCell())->tail = aList;
+
+    // The counts cached in the other cells of this list are now wrong.
+    cellsDidChange();
+    cacheCount(newCount, newLast);
+    if (compileTimeStamp > 0)
+        compileTimeStamp = 1;
+}
+
+void List::removeLastInPlace()
+{
+    Q_ASSERT(isKnownUnique);
+    int newCount = count() - 1;
+    Q_ASSERT(newCount > 0);
+
+    List *newLast = this;
+    for (int i = 1; i < newCount; ++i)
+        newLast = newLast->tail.listValue();
+    newLast->tail = emptyList();
+
+    cellsDidChange();
+    cacheCount(newCount, newLast);
+    if (compileTimeStamp > 0)
+        compileTimeStamp = 1;
+}
+
 ListIterator List::newIterator() const
 {
     // Safe: ListIterator only reads from the list, it never modifies it.
@@ -0,0 +1,178 @@
+//===-- qlogo/datum_pool.cpp - DatumPool class implementation -------*- C++ -*-===//
+//
+// Copyright 2017-2024 Jason Sikes
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the conditions specified in the
+// license found in the LICENSE file in the project root.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the DatumPool class, a slab allocator
+/// for Datum objects.
+///
+//===----------------------------------------------------------------------===//
+
+#include "datum_pool.h"
+#include "sharedconstants.h"
+#include <cstring>
+#include <new>
+
+DatumPool::Slab *DatumPool::newSlab(int sizeClass)
+{
+    void *memory = ::operator new(slabSize, std::align_val_t(slabSize));
+    auto *slab = static_cast<Slab *>(memory);
+    size_t headerSize = (sizeof(Slab) + granularity - 1) / granularity * granularity;
+
+    slab->prev = nullptr;
+    slab->next = nullptr;
+    slab->prevInPool = nullptr;
+    slab->nextInPool = allSlabs;
+    if (allSlabs != nullptr)
+        allSlabs->prevInPool = slab;
+    allSlabs = slab;
+    slab->freeList = nullptr;
+    slab->bump = static_cast<char *>(memory) + headerSize;
+    slab->end = static_cast<char *>(memory) + slabSize;
+    slab->liveCount = 0;
+    slab->sizeClass = sizeClass;
+
+    ++slabsInClass[sizeClass];
+    bytesInSlabs += slabSize;
+    pushFront(slab);
+    return slab;
+}
+
+void DatumPool::releaseSlab(Slab *slab)
+{
+    --slabsInClass[slab->sizeClass];
+    bytesInSlabs -= slabSize;
+    if (slab->prevInPool != nullptr)
+        slab->prevInPool->nextInPool = slab->nextInPool;
+    else
+        allSlabs = slab->nextInPool;
+    if (slab->nextInPool != nullptr)
+        slab->nextInPool->prevInPool = slab->prevInPool;
+    ::operator delete(static_cast<void *>(slab), std::align_val_t(slabSize));
+}
+
+void DatumPool::unlink(Slab *slab)
+{
+    if (slab->prev != nullptr)
+        slab->prev->next = slab->next;
+    else
+        partialSlabs[slab->sizeClass] = slab->next;
+    if (slab->next != nullptr)
+        slab->next->prev = slab->prev;
+    slab->prev = nullptr;
+    slab->next = nullptr;
+}
+
+void DatumPool::pushFront(Slab *slab)
+{
+    Slab *&head = partialSlabs[slab->sizeClass];
+    slab->prev = nullptr;
+    slab->next = head;
+    if (head != nullptr)
+        head->prev = slab;
+    head = slab;
+}
+
+void *DatumPool::allocate(size_t size)
+{
+    // The allocator can't change once objects exist, so the choice is fixed on first use.
+    if (!isModeSet)
+    {
+        usesSlabs = Config::get().useSlabAllocator;
+        isModeSet = true;
+    }
+
+    bytesInUse += size;
+    if (bytesInUse > maxBytesInUse)
+        maxBytesInUse = bytesInUse;
+    if (!usesSlabs || (size > maxPooledSize))
+    {
+        bytesOutsideSlabs += size;
+        return ::operator new(size);
+    }
+
+    int sizeClass = static_cast<int>((size - 1) / granularity);
+    size_t cellSize = (sizeClass + 1) * granularity;
+    Slab *slab = partialSlabs[sizeClass];
+    if (slab == nullptr)
+        slab = newSlab(sizeClass);
+
+    void *retval;
+    if (slab->freeList != nullptr)
+    {
+        retval = slab->freeList;
+        slab->freeList = slab->freeList->next;
+    }
+    else
+    {
+        retval = slab->bump;
+        slab->bump += cellSize;
+    }
+    ++slab->liveCount;
+
+    // A full slab leaves the list of partial slabs until one of its objects is freed.
+    if ((slab->freeList == nullptr) && (slab->bump + cellSize > slab->end))
+        unlink(slab);
+
+    return retval;
+}
+
+void DatumPool::deallocate(void *p, size_t size)
+{
+    bytesInUse -= size;
+    if (!usesSlabs || (size > maxPooledSize))
+    {
+        bytesOutsideSlabs -= size;
+        ::operator delete(p);
+        return;
+    }
+
+    auto *slab = reinterpret_cast<Slab *>(reinterpret_cast<uintptr_t>(p) & ~static_cast<uintptr_t>(slabSize - 1));
+    size_t cellSize = (slab->sizeClass + 1) * granularity;
+    bool wasFull = (slab->freeList == nullptr) && (slab->bump + cellSize > slab->end);
+
+    auto *cell = static_cast<FreeCell *>(p);
+    cell->next = slab->freeList;
+    slab->freeList = cell;
+    --slab->liveCount;
+
+    if (wasFull)
+        pushFront(slab);
+
+    // Reclaim an empty slab as a whole. Keep the last slab of each size class so that
+    // a single object being created and destroyed repeatedly doesn't thrash the system
+    // allocator.
+    if ((slab->liveCount == 0) && (slabsInClass[slab->sizeClass] > 1))
+    {
+        unlink(slab);
+        releaseSlab(slab);
+    }
+}
+
+void DatumPool::forEachLiveObject(const std::function<void(const void *, size_t)> &visit) const
+{
+    size_t headerSize = (sizeof(Slab) + granularity - 1) / granularity * granularity;
+    for (const Slab *slab = allSlabs; slab != nullptr; slab = slab->nextInPool)
+    {
+        auto slabStart = reinterpret_cast<uintptr_t>(slab);
+        size_t cellSize = (slab->sizeClass + 1) * granularity;
+        for (const char *cell = reinterpret_cast<const char *>(slab) + headerSize; cell < slab->bump;
+             cell += cellSize)
+        {
+            // A free cell begins with its free-list link, which is either null or points
+            // into the same slab. A live object begins with its vtable pointer, which
+            // points into the program image, never into a slab.
+            uintptr_t firstWord;
+            std::memcpy(&firstWord, cell, sizeof(firstWord));
+            bool isFree = (firstWord == 0) || ((firstWord & ~static_cast<uintptr_t>(slabSize - 1)) == slabStart);
+            if (!isFree)
+                visit(cell, cellSize);
+        }
+    }
+}
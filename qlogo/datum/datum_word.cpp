@@ -16,8 +16,13 @@
 //===----------------------------------------------------------------------===//
 
 #include "datum_types.h"
+#include <QHash>
 #include <QObject>
 #include <array>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <qdebug.h>
 
 namespace
@@ -232,98 +237,591 @@ QString toBackslashedString(const QString &src)
     return retval;
 }
 
+namespace
+{
+/// @brief The key and printable forms of words that differ from their raw forms.
+struct WordForms
+{
+    QString printable;
+    QString key;
+};
+
+/// @brief Return true if every character of s fits in one byte of Latin-1. The raw
+/// characters that stand in for delimiters are all below 32, so they fit, too.
+bool isLatin1String(const QString &s)
+{
+    for (QChar c : s)
+    {
+        if (c.unicode() > 0xFF)
+            return false;
+    }
+    return true;
+}
+
+/// @brief The powers of ten that a double holds exactly.
+constexpr std::array<double, 23> exactPowersOfTen = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                                     1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                                     1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+/// @brief Parse a numeral of the form -?[0-9]+(.[0-9]+)?([eE][-+]?[0-9]+)? whose value can
+/// be computed exactly with a single rounding (Clinger's fast path), i.e. whose digits fit
+/// in 53 bits and whose decimal exponent is within 22.
+/// @param length The number of characters.
+/// @param charAt A function returning the character at an index.
+/// @param retval Set to the value of the numeral.
+/// @return True if the numeral was parsed. If false, the text may still be a number that
+/// needs a full parser.
+template <typename CharAt>
+bool parseSimpleNumber(qsizetype length, CharAt charAt, double &retval)
+{
+    constexpr quint64 maxExactMantissa = 1ULL << 53;
+    qsizetype i = 0;
+    bool isNegative = false;
+    quint64 mantissa = 0;
+    int exponent = 0;
+
+    auto digitAt = [&charAt](qsizetype index) {
+        char16_t c = charAt(index).unicode();
+        return ((c >= '0') && (c <= '9')) ? static_cast<int>(c - '0') : -1;
+    };
+    auto appendDigit = [&mantissa](int digit) {
+        if (mantissa > (maxExactMantissa - digit) / 10)
+            return false;
+        mantissa = mantissa * 10 + digit;
+        return true;
+    };
+
+    if ((length > 0) && (charAt(0) == QLatin1Char('-')))
+    {
+        isNegative = true;
+        ++i;
+    }
+
+    qsizetype firstDigit = i;
+    for (; (i < length) && (digitAt(i) >= 0); ++i)
+    {
+        if (!appendDigit(digitAt(i)))
+            return false;
+    }
+    if (i == firstDigit)
+        return false;
+
+    if ((i < length) && (charAt(i) == QLatin1Char('.')))
+    {
+        ++i;
+        qsizetype firstFractionDigit = i;
+        for (; (i < length) && (digitAt(i) >= 0); ++i)
+        {
+            if (!appendDigit(digitAt(i)))
+                return false;
+            --exponent;
+        }
+        if (i == firstFractionDigit)
+            return false;
+    }
+
+    if ((i < length) && ((charAt(i) == QLatin1Char('e')) || (charAt(i) == QLatin1Char('E'))))
+    {
+        ++i;
+        bool isExponentNegative = false;
+        if ((i < length) && ((charAt(i) == QLatin1Char('-')) || (charAt(i) == QLatin1Char('+'))))
+        {
+            isExponentNegative = (charAt(i) == QLatin1Char('-'));
+            ++i;
+        }
+        qsizetype firstExponentDigit = i;
+        int exponentPart = 0;
+        for (; (i < length) && (digitAt(i) >= 0); ++i)
+        {
+            // Any exponent this large is out of the fast path's range anyway.
+            if (exponentPart > 1000)
+                return false;
+            exponentPart = exponentPart * 10 + digitAt(i);
+        }
+        if (i == firstExponentDigit)
+            return false;
+        exponent += isExponentNegative ? -exponentPart : exponentPart;
+    }
+
+    if (i != length)
+        return false;
+
+    if (mantissa == 0)
+    {
+        retval = isNegative ? -0.0 : 0.0;
+        return true;
+    }
+    if ((exponent < -22) || (exponent > 22))
+        return false;
+
+    retval = static_cast<double>(mantissa);
+    if (exponent < 0)
+        retval /= exactPowersOfTen[-exponent];
+    else
+        retval *= exactPowersOfTen[exponent];
+    if (isNegative)
+        retval = -retval;
+    return true;
+}
+
+/// @brief Only a few words ever need their key or printable forms stored separately from
+/// their raw string, so those forms are kept here rather than in every Word.
+QHash<const Word *, WordForms> &formCache()
+{
+    // Never destroyed, since Words may outlive static destruction.
+    static auto *cache = new QHash<const Word *, WordForms>;
+    return *cache;
+}
+
+/// @brief The key forms of interned words, which are the names that compiled code looks up
+/// variables and procedures by. Each distinct key is stored once, and keyIndex of a word is
+/// its index here, so asking an interned word for its key again doesn't build a string.
+/// Index 0 means no key has been stored.
+struct KeyTable
+{
+    QList<QString> keys = {QString()};
+    QHash<QString, quint32> indexes;
+};
+
+KeyTable &keyTable()
+{
+    // Never destroyed, since Words may outlive static destruction.
+    static auto *table = new KeyTable;
+    return *table;
+}
+
+/// @brief The interned words, by raw string. Words written with vertical bars are kept
+/// apart from those that weren't, since the two parse differently.
+QHash<QString, Word *> &internTable(bool isForeverSpecial)
+{
+    // Never destroyed, since Words may outlive static destruction.
+    static auto *tables = new QHash<QString, Word *>[2];
+    return tables[isForeverSpecial ? 1 : 0];
+}
+} // namespace
+
+// A word holding a number must fit in the 48-byte size class of the DatumPool.
+static_assert(sizeof(Word) <= 48, "Word has outgrown its compact layout");
+
 Word::Word()
 {
     isa = Datum::typeWord;
-    number = nan("");
-    rawString = QString();
-    printableString = QString();
-    keyString = QString();
     sourceIsNumber = false;
-    // qDebug() <<this << " new++ word";
+    boolean = false;
+    hasString = false;
+    isInline = false;
+    isLatin1 = false;
+    printableIsRaw = false;
+    keyIsRaw = false;
+    hasCachedForms = false;
+    hasParsedNumber = false;
+    hasParsedBool = false;
+    isInterned = false;
+    inlineLength = 0;
+    keyIndex = 0;
+    number = nan("");
+    heap = {nullptr, 0, 0};
+    isForeverSpecial = false;
+    numberIsValid = false;
+    boolIsValid = false;
 }
 
-Word::Word(const QString &other, bool aIsForeverSpecial)
+Word::Word(const QString &other, bool aIsForeverSpecial) : Word()
 {
-    isa = Datum::typeWord;
-    number = nan("");
     isForeverSpecial = aIsForeverSpecial;
-    rawString = other;
-    printableString = QString();
-    keyString = QString();
-    sourceIsNumber = false;
-    // qDebug() <<this << " new++ word: " <<other;
+    setRawString(other);
 }
 
-Word::Word(double other)
+Word::Word(double other) : Word()
 {
-    isa = Datum::typeWord;
     numberIsValid = !std::isnan(other);
     number = other;
-    rawString = QString();
-    printableString = QString();
-    keyString = QString();
     sourceIsNumber = true;
-    // qDebug() <<this << " new++ word: " <<other;
+    hasParsedNumber = true;
+}
+
+Word::~Word()
+{
+    if (hasCachedForms)
+        formCache().remove(this);
+    if (isInterned)
+        internTable(isForeverSpecial).remove(rawString());
+    if (hasString && !isInline)
+        releaseText();
+}
+
+Word *Word::intern(const QString &raw, bool aIsForeverSpecial)
+{
+    Word *&entry = internTable(aIsForeverSpecial)[raw];
+    if (entry == nullptr)
+    {
+        entry = new Word(raw, aIsForeverSpecial);
+        entry->isInterned = true;
+    }
+    return entry;
+}
+
+void Word::setRawString(const QString &src) const
+{
+    Q_ASSERT(!hasString);
+    // Most words, and the strings of all but the longest numbers, are short Latin-1 text.
+    if ((src.size() <= inlineLatin1Capacity) && isLatin1String(src))
+    {
+        isInline = true;
+        isLatin1 = true;
+        inlineLength = static_cast<quint8>(src.size());
+        for (int i = 0; i < src.size(); ++i)
+            inlineLatin1[i] = static_cast<char>(src[i].unicode());
+    }
+    else if (src.size() <= inlineCapacity)
+    {
+        isInline = true;
+        inlineLength = static_cast<quint8>(src.size());
+        std::memcpy(inlineChars, src.constData(), src.size() * sizeof(char16_t));
+    }
+    else
+    {
+        isInline = false;
+        heap = {new SharedText{src, 1}, 0, static_cast<quint32>(src.size())};
+    }
+    hasString = true;
+}
+
+void Word::generateRawString() const
+{
+    Q_ASSERT(numberIsValid);
+    setRawString(formatNumber(number));
+}
+
+QString Word::rawString() const
+{
+    if (!hasString)
+        generateRawString();
+    if (isLatin1)
+        return QString::fromLatin1(inlineLatin1, inlineLength);
+    if (isInline)
+        return QString(reinterpret_cast<const QChar *>(inlineChars), inlineLength);
+
+    // The whole string is needed now, so a slice gets a copy of its own characters. From
+    // here on it can be returned without copying.
+    if ((heap.start != 0) || (heap.length != heap.text->string.size()))
+    {
+        if (heap.text->refCount == 1)
+        {
+            heap.text->string = heap.text->string.sliced(heap.start, heap.length);
+        }
+        else
+        {
+            auto *own = new SharedText{heap.text->string.sliced(heap.start, heap.length), 1};
+            releaseText();
+            heap.text = own;
+        }
+        heap.start = 0;
+    }
+    return heap.text->string;
+}
+
+void Word::releaseText() const
+{
+    if (--heap.text->refCount == 0)
+        delete heap.text;
 }
 
-Word::~Word() = default;
+void Word::appendRawTo(QString &dest) const
+{
+    if (!hasString)
+        generateRawString();
+    if (isLatin1)
+        dest.append(QLatin1StringView(inlineLatin1, inlineLength));
+    else if (isInline)
+        dest.append(reinterpret_cast<const QChar *>(inlineChars), inlineLength);
+    else if (&heap.text->string == &dest)
+    {
+        // The slice is part of dest itself, which may move as it grows, so copy it first.
+        dest.append(QStringView(dest).sliced(heap.start, heap.length).toString());
+    }
+    else
+    {
+        dest.append(QStringView(heap.text->string).sliced(heap.start, heap.length));
+    }
+}
+
+qsizetype Word::rawLength() const
+{
+    if (!hasString)
+        generateRawString();
+    if (isInline)
+        return inlineLength;
+    return heap.length;
+}
+
+QChar Word::rawCharAt(qsizetype index) const
+{
+    Q_ASSERT((index >= 0) && (index < rawLength()));
+    if (isLatin1)
+        return QChar(static_cast<uchar>(inlineLatin1[index]));
+    if (isInline)
+        return QChar(inlineChars[index]);
+    return heap.text->string.at(heap.start + index);
+}
+
+Word *Word::slice(qsizetype start, qsizetype length) const
+{
+    Q_ASSERT((start >= 0) && (length >= 0) && (start + length <= rawLength()));
+    auto *retval = new Word();
+    if (!isInline && (length > inlineLatin1Capacity))
+    {
+        ++heap.text->refCount;
+        retval->heap = {heap.text, static_cast<quint32>(heap.start + start), static_cast<quint32>(length)};
+        retval->hasString = true;
+        return retval;
+    }
+
+    // A short slice is copied, since it fits inside the new word.
+    QString text(length, Qt::Uninitialized);
+    for (qsizetype i = 0; i < length; ++i)
+        text[i] = rawCharAt(start + i);
+    retval->setRawString(text);
+    return retval;
+}
 
-void Word::genRawString() const
+Word *Word::concatenate(const Word *const *words, qsizetype count)
 {
-    if (rawString.isNull())
+    qsizetype length = 0;
+    for (qsizetype i = 0; i < count; ++i)
+        length += words[i]->rawLength();
+
+    // If the first word's slice ends its buffer, no word sees past that point, so the rest
+    // can be added there in place. This is what makes MAKE "S WORD :S :C linear instead of
+    // quadratic.
+    const Word *first = (count > 0) ? words[0] : nullptr;
+    if ((first != nullptr) && !first->isInline && (length <= std::numeric_limits<quint32>::max()) &&
+        (first->heap.start + first->heap.length == first->heap.text->string.size()))
     {
-        Q_ASSERT(numberIsValid);
-        rawString.setNum(number);
+        SharedText *text = first->heap.text;
+        for (qsizetype i = 1; i < count; ++i)
+            words[i]->appendRawTo(text->string);
+        auto *retval = new Word();
+        ++text->refCount;
+        retval->heap = {text, first->heap.start, static_cast<quint32>(length)};
+        retval->hasString = true;
+        return retval;
     }
+
+    QString retval;
+    retval.reserve(length);
+    for (qsizetype i = 0; i < count; ++i)
+        words[i]->appendRawTo(retval);
+    return new Word(retval);
 }
 
-void Word::genPrintString() const
+QString Word::printableString() const
 {
-    if (printableString.isNull())
+    if (printableIsRaw)
+        return rawString();
+    if (hasCachedForms)
     {
-        genRawString();
-        printableString = rawString;
-        rawToChar(printableString);
+        const WordForms &forms = formCache()[this];
+        if (!forms.printable.isNull())
+            return forms.printable;
     }
+
+    QString retval = rawString();
+    if (!containsRawChars(retval))
+    {
+        printableIsRaw = true;
+        return retval;
+    }
+    rawToChar(retval);
+    formCache()[this].printable = retval;
+    hasCachedForms = true;
+    return retval;
 }
 
-void Word::genKeyString() const
+QString Word::keyString() const
 {
-    if (keyString.isNull())
+    if (keyIndex != 0)
+        return keyTable().keys[keyIndex];
+    if (isInterned)
     {
-        genPrintString();
-        keyString = printableString;
-        for (int i = 0; i < keyString.size(); ++i)
+        QString key = generateKeyString();
+        KeyTable &table = keyTable();
+        quint32 &index = table.indexes[key];
+        if (index == 0)
         {
-            QChar s = printableString[i];
-            QChar d = s.toUpper();
-            if (s != d)
-                keyString[i] = d;
+            index = static_cast<quint32>(table.keys.size());
+            table.keys.append(key);
         }
+        keyIndex = index;
+        return table.keys[keyIndex];
     }
+    return generateKeyString();
+}
+
+/// Returns the printable form if it differs from the raw form, or nullptr if it doesn't.
+const QString *Word::printableForm() const
+{
+    if (!printableIsRaw && (!hasCachedForms || formCache()[this].printable.isNull()))
+        printableString();
+    if (printableIsRaw)
+        return nullptr;
+    return &formCache()[this].printable;
+}
+
+/// Returns the key form if it differs from the raw form, or nullptr if it doesn't.
+const QString *Word::keyForm() const
+{
+    if (!keyIsRaw && (keyIndex == 0) && (!hasCachedForms || formCache()[this].key.isNull()))
+        keyString();
+    if (keyIsRaw)
+        return nullptr;
+    if (keyIndex != 0)
+        return &keyTable().keys[keyIndex];
+    return &formCache()[this].key;
+}
+
+QString Word::generateKeyString() const
+{
+    if (keyIsRaw)
+        return rawString();
+    if (hasCachedForms)
+    {
+        const WordForms &forms = formCache()[this];
+        if (!forms.key.isNull())
+            return forms.key;
+    }
+
+    QString retval = printableString();
+    bool isChanged = false;
+    for (int i = 0; i < retval.size(); ++i)
+    {
+        QChar s = retval[i];
+        QChar d = s.toUpper();
+        if (s != d)
+        {
+            retval[i] = d;
+            isChanged = true;
+        }
+    }
+    if (!isChanged && printableIsRaw)
+    {
+        keyIsRaw = true;
+        return retval;
+    }
+    formCache()[this].key = retval;
+    hasCachedForms = true;
+    return retval;
 }
 
 double Word::numberValue() const
 {
-    if (!numberIsValid)
+    if (!hasParsedNumber)
     {
-        genPrintString();
-        number = printableString.toDouble(&numberIsValid);
+        // Most numerals can be read straight from the raw characters. The rest, including
+        // any word with characters that print differently, go through QString::toDouble().
+        double n;
+        if (parseSimpleNumber(rawLength(), [this](qsizetype i) { return rawCharAt(i); }, n))
+        {
+            number = n;
+            numberIsValid = true;
+        }
+        else
+        {
+            bool isValid;
+            number = printableString().toDouble(&isValid);
+            numberIsValid = isValid;
+        }
+        hasParsedNumber = true;
     }
     return number;
 }
 
+QString Word::formatNumber(double n)
+{
+    char buffer[32];
+    int length = 0;
+
+    // Integers of up to six digits, which are most numbers a program prints, come out
+    // the same in %g as in %d.
+    if ((n > -1e6) && (n < 1e6) && (n == std::trunc(n)) && !((n == 0) && std::signbit(n)))
+    {
+        auto i = static_cast<qint32>(n);
+        quint32 magnitude = (i < 0) ? -static_cast<quint32>(i) : static_cast<quint32>(i);
+        char digits[8];
+        int count = 0;
+        do
+        {
+            digits[count++] = static_cast<char>('0' + (magnitude % 10));
+            magnitude /= 10;
+        } while (magnitude != 0);
+        if (i < 0)
+            buffer[length++] = '-';
+        while (count > 0)
+            buffer[length++] = digits[--count];
+        return QString::fromLatin1(buffer, length);
+    }
+
+    // Qt spells NaN and infinity its own way.
+    if (!std::isfinite(n))
+        return QString::number(n);
+
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), n, std::chars_format::general, 6);
+    Q_ASSERT(result.ec == std::errc());
+    return QString::fromLatin1(buffer, result.ptr - buffer);
+}
+
+double Word::parseNumber(QStringView s, bool *isValid)
+{
+    double retval;
+    if (parseSimpleNumber(s.size(), [s](qsizetype i) { return s[i]; }, retval))
+    {
+        *isValid = true;
+        return retval;
+    }
+    return s.toDouble(isValid);
+}
+
+quint32 Word::structuralHash() const
+{
+    // Words that are equal as numbers are EQUALP however they are spelled, e.g. 1 and 1.0.
+    double n = numberValue();
+    if (numberIsValid)
+        return hashOfNumber(n);
+    return hashOfString(printableString());
+}
+
+quint32 Word::hashOfNumber(double n)
+{
+    // NaN is never equal to anything, and 0 is equal to -0.
+    if (std::isnan(n))
+        return 0;
+    if (n == 0)
+        n = 0;
+    return static_cast<quint32>(qHash(n));
+}
+
+quint32 Word::hashOfString(const QString &s)
+{
+    return static_cast<quint32>(qHash(s.toCaseFolded()));
+}
+
 bool Word::boolValue() const
 {
-    if (!boolIsValid)
+    if (!hasParsedBool)
     {
-        genKeyString();
-        if ((keyString == "TRUE") || (keyString == "FALSE"))
+        // Only a word of four or five characters can be TRUE or FALSE, so most words are
+        // ruled out without building their key, and numbers without formatting them.
+        qsizetype length = sourceIsNumber ? 0 : rawLength();
+        if ((length == 4) || (length == 5))
         {
-            boolIsValid = true;
-            boolean = (keyString == "TRUE");
+            QString key = keyString();
+            if ((key == "TRUE") || (key == "FALSE"))
+            {
+                boolIsValid = true;
+                boolean = (key == "TRUE");
+            }
         }
+        hasParsedBool = true;
     }
     return boolean;
 }
@@ -331,24 +829,17 @@ bool Word::boolValue() const
 QString Word::toString(ToStringFlags flags, int printDepthLimit, int printWidthLimit, VisitedSet *) const
 {
     if (flags & Datum::ToStringFlags_Key)
-    {
-        genKeyString();
-        return keyString;
-    }
+        return keyString();
     if (flags & Datum::ToStringFlags_Raw)
-    {
-        genRawString();
-        return rawString;
-    }
+        return rawString();
 
     if (printDepthLimit == 0)
     {
         return "...";
     }
 
-    genPrintString();
     bool fullPrintp = (flags & (Datum::ToStringFlags_FullPrint | Datum::ToStringFlags_Source)) != 0;
-    QString srcString = (fullPrintp) ? rawString : printableString;
+    QString srcString = (fullPrintp) ? rawString() : printableString();
 
     if ((printWidthLimit >= 0) && (printWidthLimit <= 10))
     {
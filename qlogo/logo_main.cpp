@@ -17,6 +17,7 @@
 ///
 //===----------------------------------------------------------------------===//
 
+#include "allocation_profiler.h"
 #include "interface/logointerfacegui.h"
 #include "workspace/kernel.h"
 #include <QCommandLineParser>
@@ -33,8 +34,13 @@ void processOptions(QCoreApplication *a)
     QString optsethelploc = "sethelploc";
     QString optshowIR = "showIR";
     QString optshowCFG = "showCFG";
+    QString optshowLIR = "showLIR";
     QString optverifyIR = "verifyIR";
     QString optshowCON = "showCON";
+    QString optallocator = "allocator";
+    QString optgcThreshold = "gcThreshold";
+    QString optshowGC = "showGC";
+    QString optprofileAllocations = "profileAllocations";
 
     QCommandLineParser commandlineParser;
 
@@ -62,6 +68,10 @@ void processOptions(QCoreApplication *a)
          QCoreApplication::translate("main",
                                      "Show the IR code generated by llvm. "
                                      "(for debugging).")},
+        {optshowLIR,
+         QCoreApplication::translate("main",
+                                     "Show the Logo-level IR code that is passed to llvm. "
+                                     "(for debugging).")},
         {optverifyIR,
          QCoreApplication::translate("main",
                                      "Verify the IR code generated by llvm. "
@@ -74,6 +84,24 @@ void processOptions(QCoreApplication *a)
          QCoreApplication::translate("main",
                                      "Show every change in the Count Of Nodes. "
                                      "(for debugging).")},
+        {optallocator,
+         QCoreApplication::translate("main",
+                                     "Select the memory allocator for Logo data, either \"slab\" (default) "
+                                     "or \"malloc\". (for benchmarking)."),
+         QCoreApplication::translate("main", "malloc|slab")},
+        {optgcThreshold,
+         QCoreApplication::translate("main",
+                                     "Run the cycle collector after this many suspected garbage cycles. "
+                                     "0 disables the cycle collector."),
+         QCoreApplication::translate("main", "count")},
+        {optshowGC,
+         QCoreApplication::translate("main",
+                                     "Show statistics after each run of the cycle collector. "
+                                     "(for debugging).")},
+        {optprofileAllocations,
+         QCoreApplication::translate("main",
+                                     "Count the Logo objects allocated by each instruction and "
+                                     "print the counts on exit. (for profiling).")},
     });
 
     commandlineParser.process(*a);
@@ -98,6 +126,11 @@ void processOptions(QCoreApplication *a)
         Config::get().showIR = true;
     }
 
+    if (commandlineParser.isSet(optshowLIR))
+    {
+        Config::get().showLIR = true;
+    }
+
     if (commandlineParser.isSet(optverifyIR))
     {
         Config::get().verifyIR = true;
@@ -112,6 +145,43 @@ void processOptions(QCoreApplication *a)
     {
         Config::get().showCON = true;
     }
+
+    if (commandlineParser.isSet(optallocator))
+    {
+        QString allocator = commandlineParser.value(optallocator);
+        if (allocator == "malloc")
+        {
+            Config::get().useSlabAllocator = false;
+        }
+        else if (allocator != "slab")
+        {
+            qCritical() << "Unknown allocator:" << allocator;
+            commandlineParser.showHelp(1);
+        }
+    }
+
+    if (commandlineParser.isSet(optgcThreshold))
+    {
+        bool isValid;
+        int threshold = commandlineParser.value(optgcThreshold).toInt(&isValid);
+        if (!isValid || (threshold < 0))
+        {
+            qCritical() << "Invalid cycle collector threshold:" << commandlineParser.value(optgcThreshold);
+            commandlineParser.showHelp(1);
+        }
+        Config::get().cycleCollectorThreshold = threshold;
+    }
+
+    if (commandlineParser.isSet(optshowGC))
+    {
+        Config::get().showGC = true;
+    }
+
+    if (commandlineParser.isSet(optprofileAllocations))
+    {
+        Config::get().profileAllocations = true;
+        AllocationProfiler::isActive = true;
+    }
 }
 
 int main(int argc, char **argv)
@@ -545,6 +545,12 @@ const QString &StringConstants::cmdStrARRAY()
     return str;
 }
 
+const QString &StringConstants::cmdStrMDARRAY()
+{
+    static const QString str = QObject::tr("MDARRAY");
+    return str;
+}
+
 const QString &StringConstants::cmdStrLISTTOARRAY()
 {
     static const QString str = QObject::tr("LISTTOARRAY");
@@ -599,12 +605,24 @@ const QString &StringConstants::cmdStrITEM()
     return str;
 }
 
+const QString &StringConstants::cmdStrMDITEM()
+{
+    static const QString str = QObject::tr("MDITEM");
+    return str;
+}
+
 const QString &StringConstants::cmdStrSETITEM()
 {
     static const QString str = QObject::tr("SETITEM");
     return str;
 }
 
+const QString &StringConstants::cmdStrMDSETITEM()
+{
+    static const QString str = QObject::tr("MDSETITEM");
+    return str;
+}
+
 const QString &StringConstants::cmdStr_dot_SETITEM()
 {
     static const QString str = QObject::tr(".SETITEM");
@@ -767,6 +785,12 @@ const QString &StringConstants::cmdStrMEMBER()
     return str;
 }
 
+const QString &StringConstants::cmdStrREMDUP()
+{
+    static const QString str = QObject::tr("REMDUP");
+    return str;
+}
+
 const QString &StringConstants::cmdStrLOWERCASE()
 {
     static const QString str = QObject::tr("LOWERCASE");
@@ -797,6 +821,48 @@ const QString &StringConstants::cmdStrRUNPARSE()
     return str;
 }
 
+const QString &StringConstants::cmdStrDICTIONARY()
+{
+    static const QString str = QObject::tr("DICTIONARY");
+    return str;
+}
+
+const QString &StringConstants::cmdStrDICTPUT()
+{
+    static const QString str = QObject::tr("DICTPUT");
+    return str;
+}
+
+const QString &StringConstants::cmdStrDICTGET()
+{
+    static const QString str = QObject::tr("DICTGET");
+    return str;
+}
+
+const QString &StringConstants::cmdStrDICTREMOVE()
+{
+    static const QString str = QObject::tr("DICTREMOVE");
+    return str;
+}
+
+const QString &StringConstants::cmdStrDICTKEYS()
+{
+    static const QString str = QObject::tr("DICTKEYS");
+    return str;
+}
+
+const QString &StringConstants::cmdStrDICTIONARYP()
+{
+    static const QString str = QObject::tr("DICTIONARYP");
+    return str;
+}
+
+const QString &StringConstants::cmdStrDICTIONARY_Q()
+{
+    static const QString str = QObject::tr("DICTIONARY?");
+    return str;
+}
+
 const QString &StringConstants::cmdStrFORWARD()
 {
     static const QString str = QObject::tr("FORWARD");
@@ -1306,3 +1372,63 @@ const QString &StringConstants::cmdStrLOCAL()
     static const QString str = QObject::tr("LOCAL");
     return str;
 }
+
+const QString &StringConstants::cmdStrPPROP()
+{
+    static const QString str = QObject::tr("PPROP");
+    return str;
+}
+
+const QString &StringConstants::cmdStrGPROP()
+{
+    static const QString str = QObject::tr("GPROP");
+    return str;
+}
+
+const QString &StringConstants::cmdStrREMPROP()
+{
+    static const QString str = QObject::tr("REMPROP");
+    return str;
+}
+
+const QString &StringConstants::cmdStrPLIST()
+{
+    static const QString str = QObject::tr("PLIST");
+    return str;
+}
+
+const QString &StringConstants::cmdStrPLISTP()
+{
+    static const QString str = QObject::tr("PLISTP");
+    return str;
+}
+
+const QString &StringConstants::cmdStrPLIST_Q()
+{
+    static const QString str = QObject::tr("PLIST?");
+    return str;
+}
+
+const QString &StringConstants::cmdStrNODES()
+{
+    static const QString str = QObject::tr("NODES");
+    return str;
+}
+
+const QString &StringConstants::cmdStrHEAPSTATS()
+{
+    static const QString str = QObject::tr("HEAPSTATS");
+    return str;
+}
+
+const QString &StringConstants::cmdStrHEAPSNAPSHOT()
+{
+    static const QString str = QObject::tr("HEAPSNAPSHOT");
+    return str;
+}
+
+const QString &StringConstants::cmdStrALLOCATIONS()
+{
+    static const QString str = QObject::tr("ALLOCATIONS");
+    return str;
+}
@@ -42,7 +42,7 @@ void Runparser::runparseSpecialchars()
             ++runparseCIter;
         }
     }
-    runparseBuilder->append(DatumPtr(retval));
+    runparseBuilder->append(DatumPtr(Word::intern(retval)));
 }
 
 void Runparser::runparseString()
@@ -69,7 +69,7 @@ void Runparser::runparseString()
         retval += *runparseCIter;
         ++runparseCIter;
     }
-    runparseBuilder->append(DatumPtr(retval, isRunparseSourceSpecial));
+    runparseBuilder->append(DatumPtr(Word::intern(retval, isRunparseSourceSpecial)));
 }
 
 /// @brief Check if a minus sign at the start of a word should be treated as
@@ -291,7 +291,8 @@ DatumPtr Runparser::runparseNumber()
     }
 
     // Successfully parsed a number
-    double value = result.toDouble();
+    bool isValid;
+    double value = Word::parseNumber(result, &isValid);
     runparseCIter = iter;
     return DatumPtr(value);
 }
@@ -304,7 +305,7 @@ void Runparser::runparseQuotedWord()
         retval += *runparseCIter;
         ++runparseCIter;
     }
-    runparseBuilder->append(DatumPtr(retval, isRunparseSourceSpecial));
+    runparseBuilder->append(DatumPtr(Word::intern(retval, isRunparseSourceSpecial)));
 }
 
 DatumPtr Runparser::doRunparse(DatumPtr src)
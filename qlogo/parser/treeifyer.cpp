@@ -385,7 +385,7 @@ DatumPtr Treeifier::treeifyTermexp()
             DatumPtr node(new ASTNode(astNodeTypeQuotedWord()));
             node.astnodeValue()->genExpression = &Compiler::genLiteral;
             node.astnodeValue()->returnType = RequestReturnDatum;
-            node.astnodeValue()->addChild(DatumPtr(DatumPtr(name, currentToken.wordValue()->isForeverSpecial)));
+            node.astnodeValue()->addChild(DatumPtr(Word::intern(name, currentToken.wordValue()->isForeverSpecial)));
             advanceToken();
             return node;
         }
@@ -394,7 +394,7 @@ DatumPtr Treeifier::treeifyTermexp()
             DatumPtr node(new ASTNode(astNodeTypeValueOf()));
             node.astnodeValue()->genExpression = &Compiler::genValueOf;
             node.astnodeValue()->returnType = RequestReturnDatum;
-            node.astnodeValue()->addChild(DatumPtr(name));
+            node.astnodeValue()->addChild(DatumPtr(Word::intern(name)));
             advanceToken();
             return node;
         }
@@ -17,6 +17,7 @@
 #include "workspace/callframe.h"
 #include "astnode.h"
 #include "compiler.h"
+#include "cycle_collector.h"
 #include "flowcontrol.h"
 #include "workspace/kernel.h"
 #include "runparser.h"
@@ -27,12 +28,21 @@
 #include <algorithm>
 #include <vector>
 
+/// @brief The name of the variable that controls case sensitivity, as a key.
+static const QString &caseIgnoredName()
+{
+    static const QString name = QObject::tr("CASEIGNOREDP");
+    return name;
+}
+
 void CallFrameStack::setDatumForName(const DatumPtr &aDatum, const QString &name)
 {
     variables.insert(name, aDatum);
+    if (name == caseIgnoredName())
+        isCaseIgnoredCached = false;
 }
 
-DatumPtr CallFrameStack::datumForName(const QString &name) const
+const DatumPtr &CallFrameStack::datumForName(const QString &name) const
 {
     auto result = variables.find(name);
     if (result != variables.end())
@@ -60,6 +70,19 @@ DatumPtr CallFrameStack::allVariables() const
 void CallFrameStack::eraseVar(const QString &name)
 {
     variables.remove(name);
+    if (name == caseIgnoredName())
+        isCaseIgnoredCached = false;
+}
+
+bool CallFrameStack::isCaseIgnored() const
+{
+    if (!isCaseIgnoredCached)
+    {
+        const DatumPtr &val = datumForName(caseIgnoredName());
+        caseIgnored = val.isWord() && (val.toString(Datum::ToStringFlags_Key) == QObject::tr("TRUE"));
+        isCaseIgnoredCached = true;
+    }
+    return caseIgnored;
 }
 
 void CallFrameStack::setTest(bool isTrue)
@@ -159,6 +182,7 @@ Datum *CallFrame::applyProcedureParams(Datum **paramAry, uint32_t paramCount)
         }
         else
         {
+            optionalDefaults[i].listValue()->cellsWereShared();
             DatumPtr optExpression = optionalDefaults[i].listValue()->tail;
             // TODO: ensure that the generated ASTList has one root node.
             Evaluator e(optExpression, evalStack);
@@ -332,7 +356,10 @@ continueBody:
     return retval;
 }
 
-Evaluator::Evaluator(const DatumPtr &aList, QList<Evaluator *> &anEvalStack) : evalStack(anEvalStack), list(aList)
+QList<Datum *> Evaluator::releasePool;
+
+Evaluator::Evaluator(const DatumPtr &aList, QList<Evaluator *> &anEvalStack)
+    : evalStack(anEvalStack), list(aList), releasePoolBase(releasePool.size())
 {
     evalStack.push_front(this);
 }
@@ -341,17 +368,35 @@ Evaluator::~Evaluator()
 {
     Q_ASSERT(evalStack.first() == this);
 
-    for (auto &d : releasePool)
+    for (qsizetype i = releasePoolBase; i < releasePool.size(); ++i)
     {
+        Datum *d = releasePool[i];
         if ((d->isa & Datum::typePersistentMask) == 0)
         {
             (d->retainCount)--;
-            if ((d != retval) && (d->retainCount <= 0))
-                delete d;
+            if (d == retval)
+                continue;
+            if (d->retainCount == 0)
+                Datum::deleteUnreferenced(d);
+            else
+                CycleCollector::released(d);
         }
     }
+    releasePool.resize(releasePoolBase);
 
     evalStack.removeFirst();
+
+    // With the temporaries released, this is a safe point to look for garbage cycles. The
+    // caller holds the return value only by a raw pointer, so hold it here, or a cyclic
+    // return value would look like garbage.
+    if (CycleCollector::get().isCollectionDue())
+    {
+        if (retval != nullptr)
+            ++(retval->retainCount);
+        CycleCollector::get().collect();
+        if (retval != nullptr)
+            --(retval->retainCount);
+    }
 }
 
 Datum *Evaluator::exec(int32_t jumpLocation)
@@ -418,6 +463,8 @@ Datum *Evaluator::watch(const DatumPtr &d)
 
 Datum *Evaluator::watch(Datum *d)
 {
+    // Only the innermost Evaluator may add to the shared release pool.
+    Q_ASSERT(evalStack.first() == this);
     (d->retainCount)++;
     releasePool.push_back(d);
     return d;
@@ -425,13 +472,5 @@ Datum *Evaluator::watch(Datum *d)
 
 bool Evaluator::varCASEIGNOREDP()
 {
-    QString name = QObject::tr("CASEIGNOREDP");
-    DatumPtr val = Kernel::get().callStack.datumForName(name);
-    bool retval = false;
-    if (val.isWord())
-    {
-        QString word = val.toString(Datum::ToStringFlags_Key);
-        retval = word == QObject::tr("TRUE");
-    }
-    return retval;
+    return Kernel::get().callStack.isCaseIgnored();
 }
@@ -14,7 +14,10 @@
 //===----------------------------------------------------------------------===//
 
 #include "workspace/exports.h"
+#include "allocation_profiler.h"
 #include "astnode.h"
+#include "cycle_collector.h"
+#include "datum_pool.h"
 #include "interface/logointerface.h"
 #include "interface/textstream.h"
 #include "datum_types.h"
@@ -27,14 +30,46 @@
 #include "workspace/callframe.h"
 
 #include <QFile>
+#include <QHash>
 #include <QObject>
 #include <QRandomGenerator>
+#include <QSet>
 #include <QStringBuilder>
 
 #include <algorithm>
 #include <functional>
 
 bool areDatumsEqual(VisitedMap &visited, Datum *d1, Datum *d2, Qt::CaseSensitivity cs);
+bool areWordsEqual(Word *w1, Word *w2, Qt::CaseSensitivity cs);
+
+/// @brief Check if a member of a container is equal to a datum, or recursively contains it.
+/// @param visited The set of visited nodes.
+/// @param value The value to check for.
+/// @param item The member to check. A packed number or boolean is read without being boxed,
+/// so that the container keeps its packed value.
+/// @param cs The case sensitivity to use for the comparison.
+/// @return True if the member is or contains the value, false otherwise.
+static bool isDatumOrInDatum(VisitedSet &visited, Datum *value, const DatumPtr &item, Qt::CaseSensitivity cs)
+{
+    VisitedMap searched;
+    if (item.isImmediate())
+    {
+        if (!value->isWord())
+            return false;
+        // A number is only equal to a word with the same value.
+        if (item.isImmediateNumber())
+            return value->wordValue()->numberValue() == item.immediateNumber();
+        DatumPtr boxed = item;
+        return areDatumsEqual(searched, boxed.datumValue(), value, cs);
+    }
+
+    Datum *itemPtr = item.datumValue();
+    if (areDatumsEqual(searched, itemPtr, value, cs))
+        return true;
+    if (itemPtr->isArray() || itemPtr->isList() || itemPtr->isDictionary())
+        return isDatumInContainer(visited, value, itemPtr, cs);
+    return false;
+}
 
 /// @brief Recursively check if a datum is in an array.
 /// @param visited The set of visited nodes.
@@ -44,22 +79,10 @@ bool areDatumsEqual(VisitedMap &visited, Datum *d1, Datum *d2, Qt::CaseSensitivi
 /// @return True if the value is in the array, false otherwise.
 bool isDatumInArray(VisitedSet &visited, Datum *value, Array *array, Qt::CaseSensitivity cs)
 {
-    VisitedMap searched;
-    for (auto &item : array->array)
+    for (const DatumPtr &item : array->array)
     {
-        searched.clear();
-        Datum *itemPtr = item.datumValue();
-        if (areDatumsEqual(searched, itemPtr, value, cs))
+        if (isDatumOrInDatum(visited, value, item, cs))
             return true;
-        if (itemPtr->isArray() || itemPtr->isList())
-        {
-            if ( ! visited.contains(itemPtr))
-            {
-                visited.add(itemPtr);
-                if (isDatumInContainer(visited, itemPtr, value, cs))
-                    return true;
-            }
-        }
     }
     return false;
 }
@@ -72,27 +95,33 @@ bool isDatumInArray(VisitedSet &visited, Datum *value, Array *array, Qt::CaseSen
 /// @return True if the value is in the list, false otherwise.
 bool isDatumInList(VisitedSet &visited, Datum *value, List *list, Qt::CaseSensitivity cs)
 {
-    VisitedMap searched;
     while (list != EmptyList::instance())
     {
-        Datum *itemPtr = list->head.datumValue();
-        searched.clear();
-        if (areDatumsEqual(searched, itemPtr, value, cs))
+        if (isDatumOrInDatum(visited, value, list->head, cs))
             return true;
-        if (itemPtr->isArray() || itemPtr->isList())
-        {
-            if (!visited.contains(itemPtr))
-            {
-                visited.add(itemPtr);
-                if (isDatumInContainer(visited, itemPtr, value, cs))
-                    return true;
-            }
-        }
         list = list->tail.listValue();
     }
     return false;
 }
 
+/// @brief Recursively check if a datum is a key or value of a dictionary.
+/// @param visited The set of visited nodes.
+/// @param value The value to check for.
+/// @param dict The dictionary to check.
+/// @param cs The case sensitivity to use for the comparison.
+/// @return True if the value is in the dictionary, false otherwise.
+bool isDatumInDictionary(VisitedSet &visited, Datum *value, Dictionary *dict, Qt::CaseSensitivity cs)
+{
+    for (const Dictionary::Entry &entry : dict->entries)
+    {
+        if (entry.key.isNothing())
+            continue;
+        if (isDatumOrInDatum(visited, value, entry.key, cs) || isDatumOrInDatum(visited, value, entry.value, cs))
+            return true;
+    }
+    return false;
+}
+
 /// @brief Recursively check if a datum is in a container.
 /// @param visited The set of visited nodes.
 /// @param value The value to check for.
@@ -113,7 +142,13 @@ bool isDatumInContainer(VisitedSet &visited, Datum *value, Datum *container, Qt:
         return isDatumInArray(visited, value, a, cs);
     }
 
-    // If it's not an Array then it must be a List.
+    if (container->isDictionary())
+    {
+        Dictionary *d = container->dictionaryValue();
+        return isDatumInDictionary(visited, value, d, cs);
+    }
+
+    // If it's not an Array or Dictionary then it must be a List.
     List *l = container->listValue();
     return isDatumInList(visited, value, l, cs);
 }
@@ -252,14 +287,24 @@ EXPORTC bool getValidityOfBoolForDatum(addr_t eAddr, addr_t datumAddr)
 /// Lookup the var name and return the value as a QLogo object (Word, List, etc)
 /// @param wordAddr a pointer to a Word object which contains the name of the variable
 /// @return the stored value as a QLogo object
-EXPORTC addr_t getDatumForVarname(addr_t wordAddr)
+EXPORTC addr_t getDatumForVarname(addr_t eAddr, addr_t wordAddr)
 {
     auto name = reinterpret_cast<Word *>(wordAddr)->toString(Datum::ToStringFlags_Key);
     Datum *val = Kernel::get().callStack.datumForName(name).datumValue();
-
     return reinterpret_cast<addr_t>(val);
 }
 
+/// Count a value as referenced until the evaluator is released.
+/// @param datumAddr a pointer to a Datum object, such as the value of a variable read that
+/// is still in use while Logo code runs, e.g. the first input of SE :L PROC.
+/// @return datumAddr
+EXPORTC addr_t pinDatum(addr_t eAddr, addr_t datumAddr)
+{
+    auto *e = reinterpret_cast<Evaluator *>(eAddr);
+    e->watch(reinterpret_cast<Datum *>(datumAddr));
+    return datumAddr;
+}
+
 /// Write a Datum object to the standard output device.
 /// @param datumAddr a pointer to a Datum object to print.
 /// @param useShow set to true to generate output for SHOW, false for PRINT
@@ -331,6 +376,17 @@ EXPORTC void setDatumForWord(addr_t datumAddr, addr_t wordAddr)
     Kernel::get().callStack.setDatumForName(d, w->toString(Datum::ToStringFlags_Key));
 }
 
+/// Store the given number using the given word as a variable name.
+/// @param val the value to be stored
+/// @param wordAddr a pointer to a Word object which contains the name of the variable
+/// @note The number is stored as an immediate, so no Word is created unless the
+/// variable is later read as a datum.
+EXPORTC void setDoubleForWord(double val, addr_t wordAddr)
+{
+    auto *w = reinterpret_cast<Word *>(wordAddr);
+    Kernel::get().callStack.setDatumForName(DatumPtr(val), w->toString(Datum::ToStringFlags_Key));
+}
+
 /// Run the given list. Output whatever the list outputs.
 /// @param eAddr a pointer to the Evaluator object context.
 /// @param listAddr a pointer to a List object which contains QLogo instructions to run
@@ -719,9 +775,9 @@ EXPORTC addr_t getCurrentError(addr_t eAddr)
 EXPORTC addr_t callPause(addr_t eAddr)
 {
     auto *e = reinterpret_cast<Evaluator *>(eAddr);
-    Datum *retval = Kernel::get().pause().datumValue();
+    DatumPtr retval = Kernel::get().pause();
     e->watch(retval);
-    return reinterpret_cast<addr_t>(retval);
+    return reinterpret_cast<addr_t>(retval.datumValue());
 }
 
 EXPORTC addr_t generateContinue(addr_t eAddr, addr_t outputAddr)
@@ -814,6 +870,24 @@ EXPORTC bool cmpDatumToDatum(addr_t eAddr, addr_t d1, addr_t d2)
     auto *dD1 = reinterpret_cast<Datum *>(d1);
     auto *dD2 = reinterpret_cast<Datum *>(d2);
     auto *e = reinterpret_cast<Evaluator *>(eAddr);
+    if (dD1 == dD2)
+        return true;
+
+    // Comparing two words needs no record of visited lists, and a word can only equal a word.
+    bool isWord1 = dD1->isWord();
+    bool isWord2 = dD2->isWord();
+    if (isWord1 != isWord2)
+        return false;
+    if (isWord1)
+    {
+        Word *w1 = dD1->wordValue();
+        Word *w2 = dD2->wordValue();
+        if (w1->isSourceNumber() && w2->isSourceNumber())
+            return w1->numberValue() == w2->numberValue();
+        Qt::CaseSensitivity cs = e->varCASEIGNOREDP() ? Qt::CaseInsensitive : Qt::CaseSensitive;
+        return areWordsEqual(w1, w2, cs);
+    }
+
     Qt::CaseSensitivity cs = e->varCASEIGNOREDP() ? Qt::CaseInsensitive : Qt::CaseSensitive;
     VisitedMap visited;
     return areDatumsEqual(visited, dD1, dD2, cs);
@@ -823,6 +897,10 @@ EXPORTC addr_t concatWord(addr_t eAddr, addr_t aryAddr, uint32_t count)
 {
     auto *e = reinterpret_cast<Evaluator *>(eAddr);
     auto **wordAry = reinterpret_cast<Word **>(aryAddr);
+    bool areAllWords = std::all_of(wordAry, wordAry + count, [](const Word *w) { return w->isWord(); });
+    if (areAllWords)
+        return reinterpret_cast<addr_t>(e->watch(Word::concatenate(wordAry, count)));
+
     QString retval;
     for (uint32_t i = 0; i < count; ++i)
     {
@@ -837,14 +915,19 @@ EXPORTC bool isDatumEmpty(addr_t dAddr)
     auto *d = reinterpret_cast<Datum *>(dAddr);
     if (d->isWord())
     {
-        return d->toString(Datum::ToStringFlags_Raw).isEmpty();
+        return d->wordValue()->rawLength() == 0;
     }
     else if (d->isList())
     {
         return d->listValue()->isEmpty();
     }
+    else if (d->isDictionary())
+    {
+        // A dictionary has no first or last member.
+        return true;
+    }
 
-    // If it's not a Word or a List then it must be an Array.
+    // If it's not a Word, List or Dictionary then it must be an Array.
     return d->arrayValue()->array.isEmpty();
 }
 
@@ -876,7 +959,7 @@ EXPORTC addr_t createSentence(addr_t eAddr, addr_t aryAddr, uint32_t count)
             ListIterator it = d.listValue()->newIterator();
             while (it.elementExists())
             {
-                builder.append(it.element());
+                builder.append(it.borrowElement());
             }
         }
         else
@@ -889,6 +972,50 @@ EXPORTC addr_t createSentence(addr_t eAddr, addr_t aryAddr, uint32_t count)
     return reinterpret_cast<addr_t>(retval.datumValue());
 }
 
+/// @brief The references to a list that an in-place change expects: the variable that holds
+/// the list. A read of the variable that is still in use is pinned, and so rules the change out.
+static constexpr int inPlaceHolders = 1;
+
+/// @brief Returns true if the variable named by "nameAddr" still holds "list", and nothing else does.
+static bool isHeldOnlyByVariable(addr_t nameAddr, const List *list)
+{
+    if (!list->isUnique(inPlaceHolders))
+        return false;
+    auto name = reinterpret_cast<Word *>(nameAddr)->toString(Datum::ToStringFlags_Key);
+    return Kernel::get().callStack.datumForName(name).datumValue() == list;
+}
+
+/// SENTENCE whose output is assigned back to the variable named by "nameAddr", which held its
+/// first input. If that variable is the only holder of the list, the other inputs are added
+/// to it in place.
+EXPORTC addr_t sentenceInPlace(addr_t eAddr, addr_t nameAddr, addr_t aryAddr, uint32_t count)
+{
+    auto **ary = reinterpret_cast<Datum **>(aryAddr);
+    if ((count == 0) || !ary[0]->isList() || !isHeldOnlyByVariable(nameAddr, ary[0]->listValue()))
+        return createSentence(eAddr, aryAddr, count);
+
+    List *list = ary[0]->listValue();
+    ListBuilder builder;
+    for (uint32_t i = 1; i < count; ++i)
+    {
+        DatumPtr d = DatumPtr(ary[i]);
+        if (d.isList())
+        {
+            ListIterator it = d.listValue()->newIterator();
+            while (it.elementExists())
+            {
+                builder.append(it.borrowElement());
+            }
+        }
+        else
+        {
+            builder.append(d);
+        }
+    }
+    list->appendInPlace(builder.finishedList());
+    return reinterpret_cast<addr_t>(list);
+}
+
 EXPORTC addr_t fputList(addr_t eAddr, addr_t thingAddr, addr_t listAddr)
 {
     auto *e = reinterpret_cast<Evaluator *>(eAddr);
@@ -911,7 +1038,7 @@ EXPORTC addr_t lputList(addr_t eAddr, addr_t thingAddr, addr_t listAddr)
 
     while (it.elementExists())
     {
-        builder.append(it.element());
+        builder.append(it.borrowElement());
     }
     builder.append(DatumPtr(thing));
 
@@ -920,6 +1047,21 @@ EXPORTC addr_t lputList(addr_t eAddr, addr_t thingAddr, addr_t listAddr)
     return reinterpret_cast<addr_t>(retval.datumValue());
 }
 
+/// LPUT whose output is assigned back to the variable named by "nameAddr", which held "list".
+/// If that variable is the only holder of the list, the list is extended in place.
+EXPORTC addr_t lputListInPlace(addr_t eAddr, addr_t nameAddr, addr_t thingAddr, addr_t listAddr)
+{
+    auto *thing = reinterpret_cast<Datum *>(thingAddr);
+    auto *list = reinterpret_cast<List *>(listAddr);
+
+    // Appending a list to itself in place would make it circular.
+    if ((thing == list) || !isHeldOnlyByVariable(nameAddr, list))
+        return lputList(eAddr, thingAddr, listAddr);
+
+    list->appendInPlace(DatumPtr(new List(DatumPtr(thing), EmptyList::instance())));
+    return listAddr;
+}
+
 EXPORTC addr_t createArray(addr_t eAddr, int32_t size, int32_t origin)
 {
     auto *e = reinterpret_cast<Evaluator *>(eAddr);
@@ -940,7 +1082,7 @@ EXPORTC addr_t listToArray(addr_t eAddr, addr_t listAddr, int32_t origin)
     ListIterator it = list->newIterator();
     while (it.elementExists())
     {
-        retval->array.append(it.element());
+        retval->array.append(it.borrowElement());
     }
     e->watch(retval);
     return reinterpret_cast<addr_t>(retval);
@@ -968,7 +1110,7 @@ EXPORTC addr_t firstOfDatum(addr_t eAddr, addr_t thingAddr)
     if (thing->isWord())
     {
         Word *w = thing->wordValue();
-        retval = new Word(w->toString(Datum::ToStringFlags_Raw).left(1));
+        retval = w->slice(0, 1);
     }
     else if (thing->isList())
     {
@@ -993,18 +1135,20 @@ EXPORTC addr_t lastOfDatum(addr_t eAddr, addr_t thingAddr)
     if (thing->isWord())
     {
         Word *w = thing->wordValue();
-        retval = new Word(w->toString(Datum::ToStringFlags_Raw).right(1));
+        retval = w->slice(w->rawLength() - 1, 1);
     }
     else if (thing->isList())
     {
         List *l = thing->listValue();
-        ListIterator iter = l->newIterator();
-        DatumPtr lastElement;
-        while (iter.elementExists())
+        const List *lastCell = l->lastCell();
+        if (lastCell == nullptr)
         {
-            lastElement = iter.element();
+            // A circular list has no last cell, so walk it as we always have.
+            lastCell = l;
+            while (lastCell->tail.listValue() != EmptyList::instance())
+                lastCell = lastCell->tail.listValue();
         }
-        retval = lastElement.datumValue();
+        retval = lastCell->head.datumValue();
     }
     else
     {
@@ -1024,13 +1168,13 @@ EXPORTC addr_t butFirstOfDatum(addr_t eAddr, addr_t thingAddr)
     if (thing->isWord())
     {
         Word *w = thing->wordValue();
-        QString rawValue = w->toString(Datum::ToStringFlags_Raw);
-        retval = new Word(rawValue.sliced(1, rawValue.size() - 1));
+        retval = w->slice(1, w->rawLength() - 1);
     }
     else
     {
         // If it's not a Word then it must be a List.
         List *l = thing->listValue();
+        l->cellsWereShared();
         retval = l->tail.datumValue();
     }
     e->watch(retval);
@@ -1045,8 +1189,7 @@ EXPORTC addr_t butLastOfDatum(addr_t eAddr, addr_t thingAddr)
     if (thing->isWord())
     {
         Word *w = thing->wordValue();
-        QString rawValue = w->toString(Datum::ToStringFlags_Raw);
-        Datum *retval = new Word(rawValue.sliced(0, rawValue.size() - 1));
+        Datum *retval = w->slice(0, w->rawLength() - 1);
         e->watch(retval);
         return reinterpret_cast<addr_t>(retval);
     }
@@ -1057,7 +1200,7 @@ EXPORTC addr_t butLastOfDatum(addr_t eAddr, addr_t thingAddr)
     ListBuilder builder;
     while (iter.elementExists())
     {
-        DatumPtr element = iter.element();
+        const DatumPtr &element = iter.borrowElement();
         if (iter.elementExists())
         {
             builder.append(element);
@@ -1068,6 +1211,19 @@ EXPORTC addr_t butLastOfDatum(addr_t eAddr, addr_t thingAddr)
     return reinterpret_cast<addr_t>(retval.datumValue());
 }
 
+/// BUTLAST whose output is assigned back to the variable named by "nameAddr", which held
+/// "thing". If that variable is the only holder of the list, its last cell is removed in place.
+EXPORTC addr_t butLastInPlace(addr_t eAddr, addr_t nameAddr, addr_t thingAddr)
+{
+    auto *thing = reinterpret_cast<Datum *>(thingAddr);
+    if (!thing->isList() || (thing->listValue()->count() < 2) ||
+        !isHeldOnlyByVariable(nameAddr, thing->listValue()))
+        return butLastOfDatum(eAddr, thingAddr);
+
+    thing->listValue()->removeLastInPlace();
+    return thingAddr;
+}
+
 EXPORTC bool isDatumIndexValid(addr_t thingAddr, double dIndex, addr_t listItemPtrAddr)
 {
     auto *thing = reinterpret_cast<Datum *>(thingAddr);
@@ -1079,26 +1235,34 @@ EXPORTC bool isDatumIndexValid(addr_t thingAddr, double dIndex, addr_t listItemP
     if (thing->isWord())
     {
         Word *w = thing->wordValue();
-        QString rawValue = w->toString(Datum::ToStringFlags_Raw);
-        return (index >= 1) && (index <= rawValue.size());
+        return (index >= 1) && (index <= w->rawLength());
     }
     else if (thing->isList())
     {
         List *l = thing->listValue();
         if (index < 1)
             return false;
-        ListIterator iter = l->newIterator();
-        while (iter.elementExists())
+        // Walk the list cells directly so that only the chosen element is boxed, and
+        // in the list itself rather than in a temporary copy.
+        while (l != EmptyList::instance())
         {
-            *listItemPtr = iter.element().datumValue();
             index--;
             if (index == 0)
+            {
+                *listItemPtr = l->head.datumValue();
                 return true;
+            }
+            l = l->tail.listValue();
         }
         return false;
     }
+    else if (thing->isDictionary())
+    {
+        // A dictionary is indexed by its keys, with DICTGET.
+        return false;
+    }
 
-    // If it's not a Word or a List then it must be an Array.
+    // If it's not a Word, List or Dictionary then it must be an Array.
     Array *a = thing->arrayValue();
     auto size = static_cast<int32_t>(a->array.size());
     index = index - a->origin;
@@ -1115,8 +1279,7 @@ EXPORTC addr_t itemOfDatum(addr_t eAddr, addr_t thingAddr, double dIndex, addr_t
     if (thing->isWord())
     {
         Word *w = thing->wordValue();
-        QString rawValue = w->toString(Datum::ToStringFlags_Raw);
-        retval = new Word(rawValue[index - 1]);
+        retval = w->slice(index - 1, 1);
     }
     else if (thing->isList())
     {
@@ -1128,12 +1291,37 @@ EXPORTC addr_t itemOfDatum(addr_t eAddr, addr_t thingAddr, double dIndex, addr_t
         // If it's not a Word or a List then it must be an Array.
         Array *a = thing->arrayValue();
         index = index - a->origin;
-        retval = a->array[index].datumValue();
+        const DatumPtr &element = a->array.at(index);
+        if (element.isImmediateNumber())
+            retval = new Word(element.immediateNumber());
+        else
+            retval = element.datumValue();
     }
     e->watch(retval);
     return reinterpret_cast<addr_t>(retval);
 }
 
+/// Query whether the member of an array selected by a valid index is a packed number.
+/// @param thingAddr a pointer to the Word, List or Array given to ITEM.
+/// @param dIndex the index, already validated by isDatumIndexValid.
+/// @return true iff thing is an Array and the member is a number packed in it.
+EXPORTC bool isItemPackedNumber(addr_t thingAddr, double dIndex)
+{
+    auto *thing = reinterpret_cast<Datum *>(thingAddr);
+    if (!thing->isArray())
+        return false;
+    Array *a = thing->arrayValue();
+    return a->array.at(static_cast<qsizetype>(dIndex) - a->origin).isImmediateNumber();
+}
+
+/// Return the packed number selected by a valid index, without boxing it.
+/// @note the caller should query isItemPackedNumber first.
+EXPORTC double packedNumberOfItem(addr_t thingAddr, double dIndex)
+{
+    Array *a = reinterpret_cast<Datum *>(thingAddr)->arrayValue();
+    return a->array.at(static_cast<qsizetype>(dIndex) - a->origin).immediateNumber();
+}
+
 EXPORTC bool isDatumContainerOrInContainer(addr_t eAddr, addr_t valueAddr, addr_t containerAddr)
 {
     auto *e = reinterpret_cast<Evaluator *>(eAddr);
@@ -1168,6 +1356,8 @@ EXPORTC void setDatumAtIndexOfContainer(addr_t valueAddr, double dIndex, addr_t
             l = l->tail.listValue();
         }
         l->head = value;
+        List::structureDidChange();
+        return;
     }
 
     // If it's not a List then it must be an Array.
@@ -1175,10 +1365,217 @@ EXPORTC void setDatumAtIndexOfContainer(addr_t valueAddr, double dIndex, addr_t
     a->array[index - a->origin] = value;
 }
 
+/// Set the "index"th member of an array to a number.
+/// @param val the number to store.
+/// @param dIndex the index of the member, which has already been validated.
+/// @param arrayAddr a pointer to the Array.
+/// @note The number is stored as an immediate, so no Word is created.
+EXPORTC void setDoubleAtIndexOfArray(double val, double dIndex, addr_t arrayAddr)
+{
+    auto *a = reinterpret_cast<Array *>(arrayAddr);
+    auto index = static_cast<qsizetype>(dIndex);
+    a->array[index - a->origin] = DatumPtr(val);
+}
+
+/// @brief Get the value of a datum as an integer index.
+/// @param d The datum.
+/// @param value Set to the integer value of the datum, if it has one.
+/// @return True if the datum is a word whose value is an integer.
+static bool integerForDatum(const DatumPtr &d, qsizetype &value)
+{
+    double n;
+    if (d.isImmediateNumber())
+    {
+        n = d.immediateNumber();
+    }
+    else
+    {
+        if (!d.isWord())
+            return false;
+        Word *w = d.wordValue();
+        n = w->numberValue();
+        if (!w->numberIsValid)
+            return false;
+    }
+    value = static_cast<qsizetype>(n);
+    return value == n;
+}
+
+/// @brief Follow an index list through nested arrays.
+/// @param index A nonempty list of indices.
+/// @param array The outermost array.
+/// @param lastIndex Set to the zero-based position selected by the last index.
+/// @return The array that the last index selects from, or nullptr if any index is invalid.
+static Array *arrayForLastMdIndex(const List *index, Array *array, qsizetype &lastIndex)
+{
+    while (true)
+    {
+        qsizetype i;
+        if (!integerForDatum(index->head, i))
+            return nullptr;
+        i -= array->origin;
+        if ((i < 0) || (i >= array->array.size()))
+            return nullptr;
+        index = index->tail.listValue();
+        if (index == EmptyList::instance())
+        {
+            lastIndex = i;
+            return array;
+        }
+        const DatumPtr &member = array->array.at(i);
+        if (!member.isArray())
+            return nullptr;
+        array = member.arrayValue();
+    }
+}
+
+/// @brief Create one level of a multi-dimensional array, and the levels below it.
+static Array *newMdArray(const List *sizes, int32_t origin)
+{
+    qsizetype size = 0;
+    integerForDatum(sizes->head, size);
+    const List *innerSizes = sizes->tail.listValue();
+    auto *retval = new Array(origin, static_cast<int>(size));
+    for (qsizetype i = 0; i < size; ++i)
+    {
+        if (innerSizes == EmptyList::instance())
+            retval->array.append(emptyList());
+        else
+            retval->array.append(DatumPtr(newMdArray(innerSizes, origin)));
+    }
+    return retval;
+}
+
+/// Validate the size list given to MDARRAY.
+/// @param sizesAddr a pointer to the size list.
+/// @return true if the sizes are a nonempty list of nonnegative integers.
+EXPORTC bool isMdArraySizeListValid(addr_t sizesAddr)
+{
+    auto *sizes = reinterpret_cast<Datum *>(sizesAddr);
+    if (!sizes->isList())
+        return false;
+    const List *l = sizes->listValue();
+    if (l == EmptyList::instance())
+        return false;
+    for (; l != EmptyList::instance(); l = l->tail.listValue())
+    {
+        qsizetype size;
+        if (!integerForDatum(l->head, size) || (size < 0))
+            return false;
+    }
+    return true;
+}
+
+/// Create a multi-dimensional array, an array of arrays.
+/// @param eAddr a pointer to the Evaluator object context.
+/// @param sizesAddr a pointer to the size list, which has already been validated.
+/// @param origin the index of the first member of every dimension.
+/// @return the outermost array.
+EXPORTC addr_t createMdArray(addr_t eAddr, addr_t sizesAddr, int32_t origin)
+{
+    auto *e = reinterpret_cast<Evaluator *>(eAddr);
+    auto *sizes = reinterpret_cast<List *>(sizesAddr);
+    Array *retval = newMdArray(sizes, origin);
+    e->watch(retval);
+    return reinterpret_cast<addr_t>(retval);
+}
+
+/// Validate an index list given to MDITEM or MDSETITEM.
+/// @param indexAddr a pointer to the index list.
+/// @param arrayAddr a pointer to the outermost Array.
+/// @param isEmptyValid true if an empty index list, which selects the whole array, is valid.
+/// @return true if every index selects a member of its array, and every index but the
+/// last selects an array.
+EXPORTC bool isMdIndexValid(addr_t indexAddr, addr_t arrayAddr, bool isEmptyValid)
+{
+    auto *index = reinterpret_cast<Datum *>(indexAddr);
+    auto *array = reinterpret_cast<Array *>(arrayAddr);
+    if (!index->isList())
+        return false;
+    const List *l = index->listValue();
+    if (l == EmptyList::instance())
+        return isEmptyValid;
+    qsizetype lastIndex;
+    return arrayForLastMdIndex(l, array, lastIndex) != nullptr;
+}
+
+/// Return the array that the last index of a valid, nonempty index list selects from.
+/// @param indexAddr a pointer to the index list.
+/// @param arrayAddr a pointer to the outermost Array.
+/// @return a pointer to the innermost Array.
+EXPORTC addr_t arrayOfMdIndex(addr_t indexAddr, addr_t arrayAddr)
+{
+    auto *index = reinterpret_cast<List *>(indexAddr);
+    auto *array = reinterpret_cast<Array *>(arrayAddr);
+    qsizetype lastIndex;
+    return reinterpret_cast<addr_t>(arrayForLastMdIndex(index, array, lastIndex));
+}
+
+/// Return the member of a multi-dimensional array selected by a valid index list.
+/// @param eAddr a pointer to the Evaluator object context.
+/// @param indexAddr a pointer to the index list.
+/// @param arrayAddr a pointer to the outermost Array.
+/// @return the selected member, or the array itself if the index list is empty.
+EXPORTC addr_t mdItemOfArray(addr_t eAddr, addr_t indexAddr, addr_t arrayAddr)
+{
+    auto *e = reinterpret_cast<Evaluator *>(eAddr);
+    auto *index = reinterpret_cast<List *>(indexAddr);
+    auto *array = reinterpret_cast<Array *>(arrayAddr);
+    if (index == EmptyList::instance())
+        return arrayAddr;
+
+    qsizetype lastIndex;
+    Array *a = arrayForLastMdIndex(index, array, lastIndex);
+    const DatumPtr &element = a->array.at(lastIndex);
+    Datum *retval;
+    if (element.isImmediateNumber())
+        retval = new Word(element.immediateNumber());
+    else
+        retval = element.datumValue();
+    e->watch(retval);
+    return reinterpret_cast<addr_t>(retval);
+}
+
+/// Query whether the member of a multi-dimensional array selected by a valid index list is a
+/// packed number.
+EXPORTC bool isMdItemPackedNumber(addr_t indexAddr, addr_t arrayAddr)
+{
+    auto *index = reinterpret_cast<List *>(indexAddr);
+    if (index == EmptyList::instance())
+        return false;
+    qsizetype lastIndex;
+    Array *a = arrayForLastMdIndex(index, reinterpret_cast<Array *>(arrayAddr), lastIndex);
+    return a->array.at(lastIndex).isImmediateNumber();
+}
+
+/// Return the packed number selected by a valid index list, without boxing it.
+/// @note the caller should query isMdItemPackedNumber first.
+EXPORTC double packedNumberOfMdItem(addr_t indexAddr, addr_t arrayAddr)
+{
+    qsizetype lastIndex;
+    Array *a = arrayForLastMdIndex(
+        reinterpret_cast<List *>(indexAddr), reinterpret_cast<Array *>(arrayAddr), lastIndex);
+    return a->array.at(lastIndex).immediateNumber();
+}
+
+/// Replace the member of a multi-dimensional array selected by a valid, nonempty index list.
+/// @param valueAddr a pointer to the new value.
+/// @param indexAddr a pointer to the index list.
+/// @param arrayAddr a pointer to the outermost Array.
+EXPORTC void setDatumAtMdIndexOfArray(addr_t valueAddr, addr_t indexAddr, addr_t arrayAddr)
+{
+    auto *index = reinterpret_cast<List *>(indexAddr);
+    auto *array = reinterpret_cast<Array *>(arrayAddr);
+    qsizetype lastIndex;
+    Array *a = arrayForLastMdIndex(index, array, lastIndex);
+    a->array[lastIndex] = DatumPtr(reinterpret_cast<Datum *>(valueAddr));
+}
+
 EXPORTC void setFirstOfList(addr_t listAddr, addr_t valueAddr)
 {
     auto *l = reinterpret_cast<List *>(listAddr);
     l->head = DatumPtr(reinterpret_cast<Datum *>(valueAddr));
+    List::structureDidChange();
     if (l->compileTimeStamp > 0)
         l->compileTimeStamp = 1;
 }
@@ -1186,7 +1583,9 @@ EXPORTC void setFirstOfList(addr_t listAddr, addr_t valueAddr)
 EXPORTC void setButfirstOfList(addr_t listAddr, addr_t valueAddr)
 {
     auto *l = reinterpret_cast<List *>(listAddr);
+    l->cellsWereShared();
     l->tail = DatumPtr(reinterpret_cast<Datum *>(valueAddr));
+    List::structureDidChange();
     if (l->compileTimeStamp > 0)
         l->compileTimeStamp = 1;
 }
@@ -1197,13 +1596,17 @@ EXPORTC bool isEmpty(addr_t thingAddr)
     if (thing->isWord())
     {
         Word *word = thing->wordValue();
-        return word->toString(Datum::ToStringFlags_Raw).isEmpty();
+        return word->rawLength() == 0;
     }
     else if (thing->isList())
     {
         List *list = thing->listValue();
         return list->isEmpty();
     }
+    else if (thing->isDictionary())
+    {
+        return thing->dictionaryValue()->count() == 0;
+    }
     return false;
 }
 
@@ -1220,6 +1623,39 @@ EXPORTC bool isBefore(addr_t eAddr, addr_t word1Addr, addr_t word2Addr)
     return value1.compare(value2, cs) < 0;
 }
 
+/// @brief Return true if element is EQUALP to thing.
+/// @param thingHash The structural hash of thing, if thing is a list. Lists with a
+/// different hash are rejected without comparing them.
+static bool isElementEqual(addr_t eAddr, Datum *thing, quint32 thingHash, const DatumPtr &element)
+{
+    if (element.isImmediate())
+    {
+        if (!thing->isWord())
+            return false;
+        // A number is only equal to a word with the same value.
+        if (element.isImmediateNumber())
+            return thing->wordValue()->numberValue() == element.immediateNumber();
+        // Box a copy, so that the container keeps its packed value.
+        DatumPtr boxed = element;
+        return cmpDatumToDatum(eAddr, reinterpret_cast<addr_t>(thing), reinterpret_cast<addr_t>(boxed.datumValue()));
+    }
+    if (thing->isList() && (!element.isList() || (element.listValue()->structuralHash() != thingHash)))
+        return false;
+    return cmpDatumToDatum(eAddr, reinterpret_cast<addr_t>(thing), reinterpret_cast<addr_t>(element.datumValue()));
+}
+
+/// @brief Find the entry of a key in a dictionary.
+/// @param hash Set to the structural hash of key, for use if the key is to be added.
+/// @return The index of the key's entry, or -1 if the key isn't in the dictionary.
+static qsizetype indexOfKey(addr_t eAddr, const Dictionary *dict, Datum *key, quint32 &hash)
+{
+    DatumPtr keyPtr(key);
+    hash = List::structuralHashOf(keyPtr);
+    return dict->indexOf(keyPtr, hash, [eAddr, key, hash](const DatumPtr &entryKey, const DatumPtr &) {
+        return isElementEqual(eAddr, key, hash, entryKey);
+    });
+}
+
 EXPORTC bool isMember(addr_t eAddr, addr_t thingAddr, addr_t containerAddr)
 {
     auto *thing = reinterpret_cast<Datum *>(thingAddr);
@@ -1228,28 +1664,31 @@ EXPORTC bool isMember(addr_t eAddr, addr_t thingAddr, addr_t containerAddr)
     if (container->isWord())
     {
         Word *word = container->wordValue();
-        QString containerString = word->toString(Datum::ToStringFlags_Key);
         if (thing->isWord())
         {
-            Word *word2 = thing->wordValue();
-            QString thingString = word2->toString(Datum::ToStringFlags_Key);
-            if (thingString.length() != 1)
-            {
-                return false;
-            }
-            return containerString.contains(thingString);
+            return thing->wordValue()->withKeyView([word](auto thingKey) {
+                return (thingKey.size() == 1) &&
+                       word->withKeyView([thingKey](auto containerKey) { return containerKey.contains(thingKey); });
+            });
         }
         return false;
     }
-    else if (container->isList())
+
+    if (container->isDictionary())
+    {
+        // A dictionary's members are its keys.
+        quint32 hash;
+        return indexOfKey(eAddr, container->dictionaryValue(), thing, hash) >= 0;
+    }
+
+    quint32 thingHash = thing->isList() ? thing->listValue()->structuralHash() : 0;
+    if (container->isList())
     {
         List *list = container->listValue();
         ListIterator iter(list);
         while (iter.elementExists())
         {
-            Datum *item = iter.element().datumValue();
-            auto itemAddr = reinterpret_cast<addr_t>(item);
-            if (cmpDatumToDatum(eAddr, thingAddr, itemAddr))
+            if (isElementEqual(eAddr, thing, thingHash, iter.borrowElement()))
             {
                 return true;
             }
@@ -1260,8 +1699,8 @@ EXPORTC bool isMember(addr_t eAddr, addr_t thingAddr, addr_t containerAddr)
     // If it's not a Word or a List then it must be an Array.
     const Array *array = container->arrayValue();
 
-    return std::any_of(array->array.begin(), array->array.end(), [eAddr, thingAddr](const auto &item) {
-        return cmpDatumToDatum(eAddr, thingAddr, reinterpret_cast<addr_t>(item.datumValue()));
+    return std::any_of(array->array.begin(), array->array.end(), [eAddr, thing, thingHash](const auto &item) {
+        return isElementEqual(eAddr, thing, thingHash, item);
     });
 }
 
@@ -1274,9 +1713,9 @@ EXPORTC bool isSubstring(addr_t thing1Addr, addr_t thing2Addr)
     {
         auto *word1 = reinterpret_cast<Word *>(thing1);
         auto *word2 = reinterpret_cast<Word *>(thing2);
-        QString string1 = word1->toString(Datum::ToStringFlags_Key);
-        QString string2 = word2->toString(Datum::ToStringFlags_Key);
-        return string2.contains(string1);
+        return word1->withKeyView([word2](auto key1) {
+            return word2->withKeyView([key1](auto key2) { return key2.contains(key1); });
+        });
     }
     return false;
 }
@@ -1301,7 +1740,7 @@ EXPORTC bool isSingleCharWord(addr_t candidateAddr)
         return false;
     }
     auto *word = reinterpret_cast<Word *>(candidate);
-    return word->toString(Datum::ToStringFlags_Key).length() == 1;
+    return word->withKeyView([](auto key) { return key.size() == 1; });
 }
 
 EXPORTC bool isVbarred(addr_t cAddr)
@@ -1320,15 +1759,19 @@ EXPORTC double datumCount(addr_t thingAddr)
     if (thing->isWord())
     {
         Word *word = thing->wordValue();
-        return word->toString(Datum::ToStringFlags_Raw).length();
+        return static_cast<double>(word->rawLength());
     }
     else if (thing->isList())
     {
         List *list = thing->listValue();
         return list->count();
     }
+    else if (thing->isDictionary())
+    {
+        return static_cast<double>(thing->dictionaryValue()->count());
+    }
 
-    // If it's not a Word or a List then it must be an Array.
+    // If it's not a Word, List or Dictionary then it must be an Array.
     Array *array = thing->arrayValue();
     return array->array.size();
 }
@@ -1384,11 +1827,13 @@ EXPORTC addr_t member(addr_t eAddr, addr_t thing1Addr, addr_t thing2Addr)
 
     // If it's not a Word then it must be a list.
     List *list = thing2->listValue();
+    list->cellsWereShared();
+    quint32 thing1Hash = thing1->isList() ? thing1->listValue()->structuralHash() : 0;
     while (!list->isEmpty())
     {
-        auto listAddr = reinterpret_cast<addr_t>(list->head.datumValue());
-        if (cmpDatumToDatum(eAddr, listAddr, thing1Addr))
+        if (isElementEqual(eAddr, thing1, thing1Hash, list->head))
         {
+            e->watch(list);
             return reinterpret_cast<addr_t>(list);
         }
         list = list->tail.listValue();
@@ -1400,6 +1845,72 @@ EXPORTC addr_t member(addr_t eAddr, addr_t thing1Addr, addr_t thing2Addr)
     return reinterpret_cast<addr_t>(retval);
 }
 
+EXPORTC addr_t removeDuplicates(addr_t eAddr, addr_t thingAddr)
+{
+    auto *e = reinterpret_cast<Evaluator *>(eAddr);
+    auto *thing = reinterpret_cast<Datum *>(thingAddr);
+
+    // The rightmost of equal members is the one that remains, so the members are
+    // examined from the end.
+    if (thing->isWord())
+    {
+        // Characters are compared as MEMBERP compares them, by their key form.
+        Word *word = thing->wordValue();
+        QString raw = word->toString(Datum::ToStringFlags_Raw);
+        QString key = word->toString(Datum::ToStringFlags_Key);
+        QSet<QChar> seen;
+        QString retval;
+        for (auto i = raw.size(); i > 0; --i)
+        {
+            if (!seen.contains(key[i - 1]))
+            {
+                seen.insert(key[i - 1]);
+                retval.append(raw[i - 1]);
+            }
+        }
+        std::reverse(retval.begin(), retval.end());
+        auto *retvalWord = new Word(retval);
+        e->watch(retvalWord);
+        return reinterpret_cast<addr_t>(retvalWord);
+    }
+
+    // If it's not a Word then it must be a list. Members are bucketed by their structural
+    // hash so that each one is only compared with the members it might equal.
+    QList<DatumPtr> members;
+    ListIterator iter(thing->listValue());
+    while (iter.elementExists())
+    {
+        members.append(iter.borrowElement());
+    }
+
+    QMultiHash<quint32, qsizetype> keptMembers;
+    QList<bool> isKept(members.size(), false);
+    for (auto i = members.size(); i > 0; --i)
+    {
+        auto memberAddr = reinterpret_cast<addr_t>(members[i - 1].datumValue());
+        quint32 hash = List::structuralHashOf(members[i - 1]);
+        auto [begin, end] = keptMembers.equal_range(hash);
+        bool isDuplicate = std::any_of(begin, end, [&](qsizetype keptIndex) {
+            return cmpDatumToDatum(eAddr, memberAddr, reinterpret_cast<addr_t>(members[keptIndex].datumValue()));
+        });
+        if (!isDuplicate)
+        {
+            keptMembers.insert(hash, i - 1);
+            isKept[i - 1] = true;
+        }
+    }
+
+    ListBuilder builder;
+    for (qsizetype i = 0; i < members.size(); ++i)
+    {
+        if (isKept[i])
+            builder.append(members[i]);
+    }
+    DatumPtr retval = builder.finishedList();
+    e->watch(retval);
+    return reinterpret_cast<addr_t>(retval.datumValue());
+}
+
 EXPORTC addr_t lowercase(addr_t eAddr, addr_t wordAddr)
 {
     auto *e = reinterpret_cast<Evaluator *>(eAddr);
@@ -1455,16 +1966,94 @@ EXPORTC addr_t runparseDatum(addr_t eAddr, addr_t wordorlistAddr)
     return reinterpret_cast<addr_t>(retval);
 }
 
+EXPORTC addr_t createDictionary(addr_t eAddr)
+{
+    auto *e = reinterpret_cast<Evaluator *>(eAddr);
+    auto *retval = new Dictionary();
+    e->watch(retval);
+    return reinterpret_cast<addr_t>(retval);
+}
+
+EXPORTC void dictionaryPut(addr_t eAddr, addr_t dictAddr, addr_t keyAddr, addr_t valueAddr)
+{
+    auto *dict = reinterpret_cast<Dictionary *>(dictAddr);
+    auto *key = reinterpret_cast<Datum *>(keyAddr);
+    DatumPtr value(reinterpret_cast<Datum *>(valueAddr));
+
+    quint32 hash;
+    qsizetype index = indexOfKey(eAddr, dict, key, hash);
+    if (index >= 0)
+        dict->entries[index].value = value;
+    else
+        dict->insert(DatumPtr(key), hash, value);
+}
+
+EXPORTC addr_t dictionaryGet(addr_t eAddr, addr_t dictAddr, addr_t keyAddr)
+{
+    auto *e = reinterpret_cast<Evaluator *>(eAddr);
+    auto *dict = reinterpret_cast<Dictionary *>(dictAddr);
+    auto *key = reinterpret_cast<Datum *>(keyAddr);
+
+    // Like GPROP, a missing key has the empty list as its value.
+    quint32 hash;
+    qsizetype index = indexOfKey(eAddr, dict, key, hash);
+    const DatumPtr &retval = (index >= 0) ? dict->entries[index].value : emptyList();
+    // The value is watched so that it survives a DICTREMOVE while it is in use.
+    return reinterpret_cast<addr_t>(e->watch(retval));
+}
+
+EXPORTC void dictionaryRemove(addr_t eAddr, addr_t dictAddr, addr_t keyAddr)
+{
+    auto *dict = reinterpret_cast<Dictionary *>(dictAddr);
+    auto *key = reinterpret_cast<Datum *>(keyAddr);
+
+    quint32 hash;
+    qsizetype index = indexOfKey(eAddr, dict, key, hash);
+    if (index >= 0)
+        dict->removeAt(index);
+}
+
+EXPORTC addr_t dictionaryKeys(addr_t eAddr, addr_t dictAddr)
+{
+    auto *e = reinterpret_cast<Evaluator *>(eAddr);
+    auto *dict = reinterpret_cast<Dictionary *>(dictAddr);
+    ListBuilder builder;
+    for (const Dictionary::Entry &entry : dict->entries)
+    {
+        if (!entry.key.isNothing())
+            builder.append(entry.key);
+    }
+    DatumPtr retval = builder.finishedList();
+    e->watch(retval);
+    return reinterpret_cast<addr_t>(retval.datumValue());
+}
+
 EXPORTC void moveTurtleForward(double distance)
 {
     Turtle::get().forward(distance);
 }
 
+EXPORTC void moveTurtleForwardSteps(addr_t stepAryAddr, int32_t count)
+{
+    const auto *steps = reinterpret_cast<const double *>(stepAryAddr);
+
+    // Each step is taken separately, since a sum of steps would not round the same way,
+    // and a step may wrap or, in fence mode, throw an error.
+    for (int32_t i = 0; i < count; ++i)
+        Turtle::get().forward(steps[i]);
+}
+
 EXPORTC void moveTurtleRotate(double angle)
 {
     Turtle::get().rotate(angle);
 }
 
+EXPORTC void moveTurtleRotateSteps(addr_t stepAryAddr, int32_t count)
+{
+    const auto *steps = reinterpret_cast<const double *>(stepAryAddr);
+    Turtle::get().rotate(steps, count);
+}
+
 EXPORTC void setTurtleXY(double x, double y)
 {
     Turtle::get().setxy(x, y);
@@ -1994,6 +2583,299 @@ EXPORTC void setVarAsLocal(addr_t varname)
     currentFrame->setVarAsLocal(varNameStr);
 }
 
+/// Get the property list with the given name, creating it if needed.
+/// @param nameAddr a pointer to a Word, the name of the property list.
+/// @return a pointer to the PropertyList, which is valid until a property is removed from it.
+EXPORTC addr_t propertyListForWord(addr_t nameAddr)
+{
+    DatumPtr name(reinterpret_cast<Datum *>(nameAddr));
+    return reinterpret_cast<addr_t>(Kernel::get().plists.propertyListForName(name));
+}
+
+/// Find the property list with the given name.
+/// @param nameAddr a pointer to a Word, the name of the property list.
+/// @return a pointer to the PropertyList, or nullptr if there is none.
+EXPORTC addr_t findPropertyListForWord(addr_t nameAddr)
+{
+    DatumPtr name(reinterpret_cast<Datum *>(nameAddr));
+    return reinterpret_cast<addr_t>(Kernel::get().plists.findPropertyList(name));
+}
+
+/// Get the symbol for a property name, creating it if needed.
+/// @param nameAddr a pointer to a Word, the name of the property.
+/// @return the symbol of the property name.
+EXPORTC int32_t propertySymbolForWord(addr_t nameAddr)
+{
+    DatumPtr name(reinterpret_cast<Datum *>(nameAddr));
+    return Kernel::get().plists.symbolForPropertyName(name);
+}
+
+/// Find the symbol for a property name.
+/// @param nameAddr a pointer to a Word, the name of the property.
+/// @return the symbol of the property name, or -1 if there is none.
+EXPORTC int32_t findPropertySymbolForWord(addr_t nameAddr)
+{
+    DatumPtr name(reinterpret_cast<Datum *>(nameAddr));
+    return Kernel::get().plists.findSymbol(name);
+}
+
+EXPORTC addr_t getPropertyOfList(addr_t eAddr, addr_t plistAddr, int32_t propSymbol)
+{
+    auto *e = reinterpret_cast<Evaluator *>(eAddr);
+    auto *plist = reinterpret_cast<PropertyLists::PropertyList *>(plistAddr);
+    if (plist == nullptr)
+        return reinterpret_cast<addr_t>(emptyList().datumValue());
+    // The value is watched so that it survives a REMPROP while it is in use.
+    Datum *retval = plist->getProperty(propSymbol).datumValue();
+    e->watch(retval);
+    return reinterpret_cast<addr_t>(retval);
+}
+
+EXPORTC void setPropertyOfList(addr_t plistAddr, int32_t propSymbol, addr_t valueAddr)
+{
+    auto *plist = reinterpret_cast<PropertyLists::PropertyList *>(plistAddr);
+    plist->addProperty(propSymbol, DatumPtr(reinterpret_cast<Datum *>(valueAddr)));
+}
+
+EXPORTC void removePropertyOfList(addr_t plistAddr, int32_t propSymbol)
+{
+    auto *plist = reinterpret_cast<PropertyLists::PropertyList *>(plistAddr);
+    if (plist != nullptr)
+        Kernel::get().plists.removeProperty(plist, propSymbol);
+}
+
+EXPORTC addr_t getPropertyListOfList(addr_t eAddr, addr_t plistAddr)
+{
+    auto *e = reinterpret_cast<Evaluator *>(eAddr);
+    auto *plist = reinterpret_cast<PropertyLists::PropertyList *>(plistAddr);
+    if (plist == nullptr)
+        return reinterpret_cast<addr_t>(emptyList().datumValue());
+    DatumPtr retval = Kernel::get().plists.getPropertyList(plist);
+    e->watch(retval);
+    return reinterpret_cast<addr_t>(retval.datumValue());
+}
+
+EXPORTC bool isPropertyListNotEmpty(addr_t plistAddr)
+{
+    auto *plist = reinterpret_cast<PropertyLists::PropertyList *>(plistAddr);
+    return (plist != nullptr) && plist->isPropertyList();
+}
+
+EXPORTC addr_t nodeCounts(addr_t eAddr)
+{
+    auto *e = reinterpret_cast<Evaluator *>(eAddr);
+    ListBuilder builder;
+    builder.append(DatumPtr(Datum::liveNodeCount()));
+    builder.append(DatumPtr(Datum::maxLiveNodeCount()));
+    Datum::resetMaxLiveNodeCount();
+    DatumPool::get().resetMaxBytesInUse();
+    DatumPtr retval = builder.finishedList();
+    e->watch(retval);
+    return reinterpret_cast<addr_t>(retval.datumValue());
+}
+
+/// @brief Build a list of a name followed by numbers, e.g. [word 12 576].
+static DatumPtr statsEntry(const DatumPtr &name, std::initializer_list<double> values)
+{
+    ListBuilder builder;
+    builder.append(name);
+    for (double value : values)
+        builder.append(DatumPtr(value));
+    return builder.finishedList();
+}
+
+EXPORTC addr_t heapStats(addr_t eAddr)
+{
+    auto *e = reinterpret_cast<Evaluator *>(eAddr);
+    const DatumPool &pool = DatumPool::get();
+
+    // Walk the slabs instead of keeping counters on every allocation, so that the
+    // statistics cost nothing until they are asked for.
+    enum Kind
+    {
+        kindWord,
+        kindList,
+        kindArray,
+        kindDictionary,
+        kindProcedure,
+        kindASTNode,
+        kindFlowControl,
+        kindOther,
+        countOfKinds
+    };
+    static const char *kindNames[countOfKinds] = {
+        "word", "list", "array", "dictionary", "procedure", "astnode", "flowcontrol", "other"};
+    double counts[countOfKinds] = {};
+    double bytes[countOfKinds] = {};
+    double pooledCount = 0;
+
+    pool.forEachLiveObject([&](const void *object, size_t size) {
+        Datum::DatumType isa = static_cast<const Datum *>(object)->isa;
+        Kind kind = kindOther;
+        if (isa & Datum::typeWord)
+            kind = kindWord;
+        else if (isa & Datum::typeList)
+            kind = kindList;
+        else if (isa & Datum::typeArray)
+            kind = kindArray;
+        else if (isa & Datum::typeDictionary)
+            kind = kindDictionary;
+        else if (isa & Datum::typeProcedure)
+            kind = kindProcedure;
+        else if (isa & Datum::typeASTNode)
+            kind = kindASTNode;
+        else if (isa & Datum::typeFlowControlMask)
+            kind = kindFlowControl;
+        ++counts[kind];
+        bytes[kind] += size;
+        ++pooledCount;
+    });
+
+    ListBuilder builder;
+    for (int kind = 0; kind < countOfKinds; ++kind)
+        builder.append(statsEntry(DatumPtr(kindNames[kind]), {counts[kind], bytes[kind]}));
+    builder.append(statsEntry(DatumPtr("unpooled"),
+                              {Datum::liveNodeCount() - pooledCount,
+                               static_cast<double>(pool.countOfBytesOutsideSlabs())}));
+    builder.append(statsEntry(DatumPtr("total"),
+                              {static_cast<double>(Datum::liveNodeCount()),
+                               static_cast<double>(pool.countOfBytesInUse())}));
+    builder.append(statsEntry(DatumPtr("peak"),
+                              {static_cast<double>(Datum::maxLiveNodeCount()),
+                               static_cast<double>(pool.maxCountOfBytesInUse())}));
+    const CycleCollector &collector = CycleCollector::get();
+    builder.append(statsEntry(DatumPtr("collected"),
+                              {static_cast<double>(collector.collections()),
+                               static_cast<double>(collector.objectsCollected()),
+                               static_cast<double>(collector.bytesCollected())}));
+    DatumPtr retval = builder.finishedList();
+    e->watch(retval);
+    return reinterpret_cast<addr_t>(retval.datumValue());
+}
+
+/// @brief Count the Words, Lists, Arrays and Dictionaries reachable from a value.
+/// @param visited The nodes already counted. Nodes in it are not counted again.
+/// @param root The value to start from.
+/// @param nodes Incremented by the number of nodes found.
+/// @param bytes Incremented by the number of bytes those nodes occupy.
+static void measureReachable(QSet<const Datum *> &visited, const DatumPtr &root, double &nodes, double &bytes)
+{
+    QList<const DatumPtr *> pending = {&root};
+    while (!pending.isEmpty())
+    {
+        const DatumPtr *next = pending.takeLast();
+        // Immediates live inside their container, and persistent data is shared by everyone.
+        if (next->isImmediate() || (next->isa() & Datum::typePersistentMask))
+            continue;
+        const Datum *d = next->datumValue();
+        if (visited.contains(d))
+            continue;
+        visited.insert(d);
+        ++nodes;
+        if (next->isWord())
+        {
+            bytes += sizeof(Word);
+        }
+        else if (next->isList())
+        {
+            auto *list = static_cast<const List *>(d);
+            bytes += sizeof(List);
+            pending.append(&list->head);
+            pending.append(&list->tail);
+        }
+        else if (next->isArray())
+        {
+            auto *array = static_cast<const Array *>(d);
+            bytes += sizeof(Array) + array->array.capacity() * sizeof(DatumPtr);
+            for (const DatumPtr &item : array->array)
+                pending.append(&item);
+        }
+        else if (next->isDictionary())
+        {
+            auto *dict = static_cast<const Dictionary *>(d);
+            bytes += sizeof(Dictionary) + dict->entries.capacity() * sizeof(Dictionary::Entry);
+            for (const Dictionary::Entry &entry : dict->entries)
+            {
+                pending.append(&entry.key);
+                pending.append(&entry.value);
+            }
+        }
+    }
+}
+
+EXPORTC addr_t heapSnapshot(addr_t eAddr)
+{
+    auto *e = reinterpret_cast<Evaluator *>(eAddr);
+    struct Entry
+    {
+        DatumPtr kind;
+        DatumPtr name;
+        double nodes;
+        double bytes;
+    };
+    QList<Entry> entries;
+
+    const QHash<QString, DatumPtr> &variables = Kernel::get().callStack.variables;
+    for (auto it = variables.cbegin(); it != variables.cend(); ++it)
+    {
+        if (it.value().isNothing())
+            continue;
+        QSet<const Datum *> visited;
+        Entry entry = {DatumPtr("variable"), DatumPtr(it.key()), 0, 0};
+        measureReachable(visited, it.value(), entry.nodes, entry.bytes);
+        entries.append(entry);
+    }
+
+    const auto &plists = Kernel::get().plists.propertyLists();
+    for (const PropertyLists::PropertyList *plist : plists)
+    {
+        if (!plist->isPropertyList())
+            continue;
+        // Values shared between properties of the same list are counted once.
+        QSet<const Datum *> visited;
+        Entry entry = {DatumPtr("plist"), plist->name, 0, 0};
+        for (const auto &property : plist->properties)
+            measureReachable(visited, property.second, entry.nodes, entry.bytes);
+        entries.append(entry);
+    }
+
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+        return a.bytes > b.bytes;
+    });
+
+    ListBuilder builder;
+    for (const Entry &entry : entries)
+    {
+        ListBuilder entryBuilder;
+        entryBuilder.append(entry.kind);
+        entryBuilder.append(entry.name);
+        entryBuilder.append(DatumPtr(entry.nodes));
+        entryBuilder.append(DatumPtr(entry.bytes));
+        builder.append(entryBuilder.finishedList());
+    }
+    DatumPtr retval = builder.finishedList();
+    e->watch(retval);
+    return reinterpret_cast<addr_t>(retval.datumValue());
+}
+
+EXPORTC void enterAllocationSite(addr_t nodeAddr)
+{
+    AllocationProfiler::get().enter(reinterpret_cast<Datum *>(nodeAddr));
+}
+
+EXPORTC void leaveAllocationSite(addr_t nodeAddr)
+{
+    AllocationProfiler::get().leave(reinterpret_cast<Datum *>(nodeAddr));
+}
+
+EXPORTC addr_t allocationReport(addr_t eAddr)
+{
+    auto *e = reinterpret_cast<Evaluator *>(eAddr);
+    DatumPtr retval = AllocationProfiler::get().report();
+    e->watch(retval);
+    return reinterpret_cast<addr_t>(retval.datumValue());
+}
+
 /// @brief Handle a bad double value. If ERRACT is set, call PAUSE. Otherwise, return an error.
 /// @param eAddr a pointer to the Evaluator object
 /// @param parentAddr a pointer to the parent node
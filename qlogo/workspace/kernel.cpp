@@ -20,6 +20,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "workspace/kernel.h"
+#include "allocation_profiler.h"
 #include "astnode.h"
 #include "compiler.h"
 #include "interface/textstream.h"
@@ -50,10 +51,14 @@ bool Kernel::numbersFromList(QVector<double> &retval, const DatumPtr &listP) con
     retval.clear();
     while (iter.elementExists())
     {
-        DatumPtr n = iter.element();
-        if (!n.isWord())
+        const DatumPtr &n = iter.borrowElement();
+        double v;
+        if (n.isImmediateNumber())
+            v = n.immediateNumber();
+        else if (n.isWord())
+            v = n.wordValue()->numberValue();
+        else
             return false;
-        double v = n.wordValue()->numberValue();
         if (std::isnan(v))
             return false;
         retval.push_back(v);
@@ -104,6 +109,10 @@ DatumPtr Kernel::readEvalPrintLoop(bool isPausing, const QString &prompt)
     forever
     {
         DatumPtr result;
+        // Sites left on the profiler's stack by an instruction that ended early would
+        // otherwise be charged with whatever happens next.
+        if (!isPausing && AllocationProfiler::isActive)
+            AllocationProfiler::get().resetSiteStack();
         try
         {
             DatumPtr line = systemReadStream->readListWithPrompt(localPrompt, true);
@@ -410,5 +419,8 @@ int Kernel::run()
 
     LogoInterface::restoreSignals();
 
+    if (Config::get().profileAllocations)
+        AllocationProfiler::get().printReport();
+
     return 0;
 }
@@ -216,6 +216,7 @@ void Procedures::processListParameter(const DatumPtr &cmd, const DatumPtr &curre
 
 void Procedures::setupInstructionList(const DatumPtr &text, Procedure *body)
 {
+    text.listValue()->cellsWereShared();
     body->instructionList = text.listValue()->tail;
     if (body->instructionList.isNothing())
         body->instructionList = emptyList();
@@ -325,7 +326,7 @@ DatumPtr Procedures::procedureText(const DatumPtr &procnameP) const
 
     while (b.elementExists())
     {
-        retvalBuilder.append(b.element());
+        retvalBuilder.append(b.borrowElement());
     }
 
     return retvalBuilder.finishedList();
@@ -521,7 +522,7 @@ DatumPtr Procedures::astnodeWithLiterals(const DatumPtr &cmd, const DatumPtr &pa
     ListIterator iter = params.listValue()->newIterator();
     while (iter.elementExists())
     {
-        DatumPtr p = iter.element();
+        const DatumPtr &p = iter.borrowElement();
         auto datumNode = DatumPtr(new ASTNode(QObject::tr("literal")));
         datumNode.astnodeValue()->genExpression = &Compiler::genLiteral;
         datumNode.astnodeValue()->addChild(p);
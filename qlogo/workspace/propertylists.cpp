@@ -17,67 +17,126 @@
 
 #include "workspace/propertylists.h"
 #include "datum_types.h"
+#include <QtAlgorithms>
 
 PropertyLists::PropertyLists() = default;
 
-void PropertyLists::addProperty(const QString &plistname, const QString &propname, const DatumPtr &value)
+PropertyLists::~PropertyLists()
 {
-    if (!plists.contains(plistname))
-    {
-        plists.insert(plistname, QHash<QString, DatumPtr>());
-    }
-
-    plists[plistname][propname] = value; 
+    qDeleteAll(plists);
 }
 
-DatumPtr PropertyLists::getProperty(const QString &plistname, const QString &propname) const
+const DatumPtr &PropertyLists::PropertyList::getProperty(int propSymbol) const
 {
-    if (plists.contains(plistname) && plists[plistname].contains(propname))
-        return plists[plistname][propname];
+    for (const auto &property : properties)
+    {
+        if (property.first == propSymbol)
+            return property.second;
+    }
     return emptyList();
 }
 
-void PropertyLists::removeProperty(const QString &plistname, const QString &propname)
+void PropertyLists::PropertyList::addProperty(int propSymbol, const DatumPtr &value)
 {
-    if (plists.contains(plistname))
+    for (auto &property : properties)
     {
-        plists[plistname].remove(propname);
-        if (plists[plistname].isEmpty())
-            plists.remove(plistname);
+        if (property.first == propSymbol)
+        {
+            property.second = value;
+            return;
+        }
     }
+    properties.append({propSymbol, value});
 }
 
-DatumPtr PropertyLists::getPropertyList(const QString &plistname) const
+void PropertyLists::PropertyList::removeProperty(int propSymbol)
 {
-    ListBuilder builder;
-    const auto propertyList = plists.find(plistname);
-    if (propertyList != plists.end())
+    for (qsizetype i = 0; i < properties.size(); ++i)
     {
-        for (const auto [key, value] : propertyList->asKeyValueRange())
+        if (properties[i].first == propSymbol)
         {
-            builder.append(DatumPtr(key));
-            builder.append(value);
+            properties.removeAt(i);
+            return;
         }
     }
-    return builder.finishedList();
 }
 
-void PropertyLists::erasePropertyList(const QString &plistname)
+PropertyLists::PropertyList *PropertyLists::propertyListForName(const DatumPtr &plistname)
 {
-    plists.remove(plistname);
+    QString key = plistname.toString(Datum::ToStringFlags_Key);
+    PropertyList *&plist = plists[key];
+    if (plist == nullptr)
+    {
+        plist = new PropertyList;
+        plist->name = plistname;
+    }
+    return plist;
+}
+
+PropertyLists::PropertyList *PropertyLists::findPropertyList(const DatumPtr &plistname) const
+{
+    return plists.value(plistname.toString(Datum::ToStringFlags_Key), nullptr);
+}
+
+int PropertyLists::symbolForPropertyName(const DatumPtr &propname)
+{
+    QString key = propname.toString(Datum::ToStringFlags_Key);
+    auto symbol = symbols.constFind(key);
+    if (symbol != symbols.cend())
+        return *symbol;
+
+    int retval = static_cast<int>(symbolNames.size());
+    symbols.insert(key, retval);
+    symbolNames.append(propname);
+    return retval;
 }
 
-bool PropertyLists::isPropertyList(const QString &plistname) const
+int PropertyLists::findSymbol(const DatumPtr &propname) const
 {
-    return plists.contains(plistname);
+    return symbols.value(propname.toString(Datum::ToStringFlags_Key), -1);
+}
+
+void PropertyLists::removeProperty(PropertyList *plist, int propSymbol)
+{
+    plist->removeProperty(propSymbol);
+    if (!plist->isPropertyList() && !plist->isPinned)
+    {
+        plists.remove(plist->name.toString(Datum::ToStringFlags_Key));
+        delete plist;
+    }
+}
+
+DatumPtr PropertyLists::getPropertyList(const PropertyList *plist) const
+{
+    ListBuilder builder;
+    for (const auto &property : plist->properties)
+    {
+        builder.append(symbolNames[property.first]);
+        builder.append(property.second);
+    }
+    return builder.finishedList();
+}
+
+void PropertyLists::erasePropertyList(const DatumPtr &plistname)
+{
+    auto plist = plists.find(plistname.toString(Datum::ToStringFlags_Key));
+    if (plist == plists.end())
+        return;
+    (*plist)->properties.clear();
+    if (!(*plist)->isPinned)
+    {
+        delete *plist;
+        plists.erase(plist);
+    }
 }
 
 DatumPtr PropertyLists::allPLists() const
 {
     ListBuilder builder;
-    for (const auto name : plists.keys())
+    for (const PropertyList *plist : plists)
     {
-        builder.append(DatumPtr(name));
+        if (plist->isPropertyList())
+            builder.append(plist->name);
     }
     return builder.finishedList();
 }
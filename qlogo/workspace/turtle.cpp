@@ -234,6 +234,15 @@ void Turtle::rotate(double angle)
     Config::get().mainInterface()->setTurtlePos(&turtleTransform);
 }
 
+void Turtle::rotate(const double *angles, qsizetype count)
+{
+    // Each angle is applied separately, since rotating by a sum of angles would not
+    // round the same way.
+    for (qsizetype i = 0; i < count; ++i)
+        turtleTransform.rotate(-angles[i]);
+    Config::get().mainInterface()->setTurtlePos(&turtleTransform);
+}
+
 std::pair<double, double> Turtle::getxy() const
 {
     return {turtleTransform.dx(), turtleTransform.dy()};
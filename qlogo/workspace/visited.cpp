@@ -20,7 +20,7 @@
 
 void VisitedSet::add(const Datum *node)
 {
-    visited.insert(node);
+    visited.insert(node, true);
 }
 
 void VisitedSet::remove(const Datum *node)
@@ -30,7 +30,7 @@ void VisitedSet::remove(const Datum *node)
 
 bool VisitedSet::contains(const Datum *node) const
 {
-    return visited.contains(node);
+    return visited.find(node) != nullptr;
 }
 
 void VisitedSet::clear()
@@ -52,12 +52,13 @@ void VisitedMap::remove(const Datum *key)
 
 const Datum *VisitedMap::get(const Datum *key) const
 {
-    return visited.value(key);
+    const Datum *const *value = visited.find(key);
+    return (value != nullptr) ? *value : nullptr;
 }
 
 bool VisitedMap::contains(const Datum *key) const
 {
-    return visited.contains(key);
+    return visited.find(key) != nullptr;
 }
 
 void VisitedMap::clear()
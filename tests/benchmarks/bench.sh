@@ -0,0 +1,138 @@
+#!/bin/sh
+
+# ./bench.sh [-console] [FILENAMES...]
+#
+# Options:
+#   -console     Run the console tests instead of the benchmark scripts, and
+#                print the time and the peak heap bytes of each, then the totals.
+#                Their output is not compared; test.sh does that.
+#
+# Run benchmark script(s) one at a time and print how long each took, in
+# milliseconds. The output of each script is compared to the file with the same
+# filename except with the ".result" extension, so that a benchmark that runs
+# fast but gives the wrong answer is reported.
+#
+# FILENAMES is the list of optional names of the logo script WITH the .lg extension.
+#
+# If FILENAMES is not specified then this will go through all the .lg files
+# in the scripts directory.
+#
+# Timing requires GNU date. The scripts are run one after another, not in
+# parallel as the console tests are, so that they don't compete for the CPU.
+
+console=false
+if [ "$1" = "-console" ]; then
+    console=true
+    shift
+fi
+
+# Change to the directory of the benchmark scripts.
+bench_dir=$(dirname $0)
+if [ "$console" = true ]; then
+    cd $bench_dir/../console/tests
+else
+    cd $bench_dir/scripts
+fi
+
+logo_binary=qlogo
+logo_path="../../../qlogo/$logo_binary"
+failed_benchmarks=""
+total_time=0
+total_peak=0
+
+if [ ! -f "$logo_path" ]
+then
+    echo "Error: could not find '$logo_binary' in parent directory."
+    echo "There should be a logo executable or a symbolic link in my parent diectory."
+    exit 0
+fi
+
+if ! (date --version >/dev/null 2>&1 && date --version 2>&1 | grep -q "GNU"); then
+    echo "Error: GNU date is needed to time the benchmarks."
+    exit 0
+fi
+
+run_benchmark() {
+    f="$1"
+    case $f in
+        *.lg)
+            start_time=`date +%s%3N`
+            $logo_path < $f > "${f%.lg}.out" 2>&1
+            end_time=`date +%s%3N`
+            printf "%-24s %8s ms\n" "$f" $((end_time-start_time))
+            if ! diff "${f%.lg}.result" "${f%.lg}.out" > /dev/null
+            then
+                failed_benchmarks="$failed_benchmarks $f"
+            fi
+            rm -f "${f%.lg}.out"
+            ;;
+    esac
+}
+
+# Print the extra options for the console test $1, if any.
+test_opts() {
+    if [ -f "${1%.lg}.opts" ]; then
+        cat "${1%.lg}.opts"
+    fi
+}
+
+# Run the console test $1 and print its time and the peak number of heap bytes
+# it used, which the last line of the test asks for with HEAPSTATS. A test that
+# ends with BYE never reaches that line, so its peak is printed as "-".
+run_console_test() {
+    f="$1"
+    case $f in
+        *.lg)
+            start_time=`date +%s%3N`
+            peak=`(cat $f; echo; echo "print item 3 item 11 heapstats") | \
+                $logo_path $(test_opts $f) 2>&1 | tail -n 1 | sed 's/.*? //'`
+            end_time=`date +%s%3N`
+            elapsed=$((end_time-start_time))
+            total_time=$((total_time+elapsed))
+            case $peak in
+                ''|*[!0-9]*)
+                    peak="-"
+                    ;;
+                *)
+                    total_peak=$((total_peak+peak))
+                    ;;
+            esac
+            printf "%-32s %8s ms %12s bytes\n" "$f" $elapsed $peak
+            ;;
+    esac
+}
+
+if [ "$console" = true ]
+then
+    if [ $# -eq 0 ]
+    then
+        set -- *.lg
+    fi
+    for filename in "$@"
+    do
+        run_console_test $filename
+    done
+    echo
+    printf "%-32s %8s ms %12s bytes\n" "TOTAL" $total_time $total_peak
+    exit 0
+fi
+
+if [ $# -gt 0 ]
+then
+    for filename in "$@"
+    do
+        run_benchmark $filename
+    done
+else
+    for a in *.lg
+    do
+        run_benchmark $a
+    done
+fi
+
+if [ -n "$failed_benchmarks" ]; then
+    echo
+    echo "==== WRONG OUTPUT:$failed_benchmarks"
+    exit 1
+fi
+exit 0
@@ -14,6 +14,9 @@
 #
 # FILENAMES is the list of optional names of the logo script WITH the .lg extension.
 #
+# If a file with the same name as a script but with the ".opts" extension exists, its
+# contents are passed to qlogo as additional command-line options for that script.
+#
 # If FILENAMES is not specified then this will go through all the .lg files
 # in the tests directory.
 
@@ -63,12 +66,19 @@ if [ "$verify_ir" = true ]; then
     exe_opts="--verifyIR"
 fi
 
+# Print the extra options for the script $1, if any.
+test_opts() {
+    if [ -f "${1%.lg}.opts" ]; then
+        cat "${1%.lg}.opts"
+    fi
+}
+
 run_test() {
     f="$1"
     case $f in
         *.lg)
             echo $f
-            $logo_path $exe_opts < $f 2>&1 | diff "${f%.lg}.result" -
+            $logo_path $exe_opts $(test_opts $f) < $f 2>&1 | diff "${f%.lg}.result" -
             if [ $? -eq 1 ]
             then
                 if [ "$blacklisted" != true ] && [ "$stop_on_first_failure" = true ]; then
@@ -134,7 +144,7 @@ else
                 echo $f
                 # Run test in background
                 (
-                    $logo_path $exe_opts < $f 2>&1 | diff "${f%.lg}.result" -
+                    $logo_path $exe_opts $(test_opts $f) < $f 2>&1 | diff "${f%.lg}.result" -
                     exit_code=$?
                     # Report: (blacklisted and passed) or (not blacklisted and failed)
                     if [ "$blacklisted" = true ] && [ $exit_code -eq 0 ]; then